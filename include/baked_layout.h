@@ -0,0 +1,25 @@
+#ifndef BAKED_LAYOUT_H
+#define BAKED_LAYOUT_H
+
+#include "BakedSampler.h"
+
+// Разметка цифр, вшитая в прошивку при сборке с -DBAKED_LAYOUT (см.
+// platformio.ini). Одна панель без точек: BAKED_DIGITS цифр по 7 сегментов
+// в порядке segPos, координаты - относительно ROI, как в /getlayout.
+// Кадр - FRAME_SIZE (QQVGA), формат - формат захвата по умолчанию.
+// Пока ROI, разметка, формат и окно сенсора совпадают с этими, цифры
+// читаются развёрнутой выборкой; после любой правки - обычным планом.
+const int BAKED_DIGITS = 2;
+
+typedef BakedSampler<160, 120, LUMA_RGB565, 10, 48,
+  // цифра 0
+  BakedRect<57, 37, 6, 3>, BakedRect<66, 42, 3, 6>, BakedRect<63, 55, 3, 6>, BakedRect<53, 63, 6, 3>,
+  BakedRect<50, 55, 3, 6>, BakedRect<51, 41, 3, 6>, BakedRect<55, 50, 6, 3>,
+  // цифра 1
+  BakedRect<82, 37, 6, 3>, BakedRect<91, 42, 3, 6>, BakedRect<88, 55, 3, 6>, BakedRect<78, 63, 6, 3>,
+  BakedRect<75, 55, 3, 6>, BakedRect<76, 41, 3, 6>, BakedRect<80, 50, 6, 3>
+> BakedDigitSampler;
+
+static_assert(BakedDigitSampler::COUNT == BAKED_DIGITS * 7, "baked layout must have 7 segments per digit");
+
+#endif
@@ -0,0 +1,291 @@
+#include "DigitDecoder.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const int MAX_DEPTH = 15;
+
+TemporalVoter::~TemporalVoter() {
+  free(_bits);
+  free(_means);
+  free(_stable);
+}
+
+bool TemporalVoter::begin(int rects, int depth, int agree) {
+  if (depth < 1) depth = 1;
+  if (depth > MAX_DEPTH) depth = MAX_DEPTH;
+  if (agree < 1) agree = 1;
+  if (agree > depth) agree = depth;
+
+  if (rects != _rects || depth != _depth) {
+    free(_bits);
+    free(_means);
+    free(_stable);
+    _bits = (uint8_t*)malloc((size_t)rects * depth);
+    _means = (uint8_t*)malloc((size_t)rects * depth);
+    _stable = (uint8_t*)malloc(rects);
+    if (!_bits || !_means || !_stable) {
+      _rects = _depth = 0;
+      return false;
+    }
+  }
+  _rects = rects;
+  _depth = depth;
+  _agree = agree;
+  reset();
+  return true;
+}
+
+void TemporalVoter::reset() {
+  _head = 0;
+  _filled = 0;
+  if (_stable) memset(_stable, 0, _rects);
+}
+
+void TemporalVoter::push(const uint8_t *bits, const int *means) {
+  if (!_rects) return;
+  uint8_t *b = _bits + (size_t)_head * _rects;
+  uint8_t *m = _means + (size_t)_head * _rects;
+  for (int i = 0; i < _rects; i++) {
+    b[i] = bits[i] ? 1 : 0;
+    m[i] = (uint8_t)(means[i] < 0 ? 0 : (means[i] > 255 ? 255 : means[i]));
+  }
+  _head = (_head + 1) % _depth;
+  if (_filled < _depth) _filled++;
+
+  for (int i = 0; i < _rects; i++) {
+    int on = 0;
+    for (int f = 0; f < _filled; f++) on += _bits[(size_t)f * _rects + i];
+    if (_filled < _depth) {
+      // Пока окно не заполнено - простое большинство
+      _stable[i] = (on * 2 > _filled) ? 1 : 0;
+    } else if (_stable[i]) {
+      if (_filled - on >= _agree) _stable[i] = 0;
+    } else {
+      if (on >= _agree) _stable[i] = 1;
+    }
+  }
+}
+
+bool TemporalVoter::settled() const {
+  if (!ready()) return false;
+  int last = (_head + _depth - 1) % _depth;
+  return memcmp(_bits + (size_t)last * _rects, _stable, _rects) == 0;
+}
+
+int TemporalVoter::medianMean(int rect) const {
+  if (!_filled || rect < 0 || rect >= _rects) return 0;
+  uint8_t v[MAX_DEPTH];
+  int n = 0;
+  for (int f = 0; f < _filled; f++) {
+    uint8_t x = _means[(size_t)f * _rects + rect];
+    int j = n++;
+    while (j > 0 && v[j - 1] > x) { v[j] = v[j - 1]; j--; }
+    v[j] = x;
+  }
+  return v[n / 2];
+}
+
+ChangeDetector::~ChangeDetector() {
+  free(_ref);
+}
+
+bool ChangeDetector::begin(int count) {
+  if (count != _count) {
+    free(_ref);
+    _ref = (int16_t*)malloc(count * sizeof(int16_t));
+    _count = _ref ? count : 0;
+  }
+  _valid = false;
+  return _ref != nullptr;
+}
+
+bool ChangeDetector::changed(const int *sketch, int tolerance) {
+  bool diff = !_valid;
+  for (int i = 0; i < _count && !diff; i++) {
+    int d = sketch[i] - _ref[i];
+    if (d > tolerance || d < -tolerance) diff = true;
+  }
+  if (diff) {
+    for (int i = 0; i < _count; i++) _ref[i] = (int16_t)sketch[i];
+    _valid = true;
+  }
+  return diff;
+}
+
+bool GlyphClassifier::addGlyph(uint32_t mask, char symbol) {
+  if (_count >= MAX_GLYPHS) return false;
+  _masks[_count] = mask;
+  _symbols[_count] = symbol;
+  _count++;
+  return true;
+}
+
+GlyphMatch GlyphClassifier::classify(const int *means, int segments, int threshold) const {
+  // Свидетельство каждого сегмента: >0 - горит, <0 - погашен, по модулю до SOFT_RANGE
+  int e[32];
+  if (segments > 32) segments = 32;
+  for (int s = 0; s < segments; s++) {
+    int v = means[s] - threshold;
+    e[s] = v < -SOFT_RANGE ? -SOFT_RANGE : (v > SOFT_RANGE ? SOFT_RANGE : v);
+  }
+
+  int best = -1, bestDist = 0x7FFFFFFF, secondDist = 0x7FFFFFFF;
+  for (int g = 0; g < _count; g++) {
+    int dist = 0;
+    for (int s = 0; s < segments; s++) {
+      int t = ((_masks[g] >> s) & 1) ? e[s] : -e[s];
+      dist += SOFT_RANGE - t;
+    }
+    if (dist < bestDist) {
+      secondDist = bestDist;
+      bestDist = dist;
+      best = g;
+    } else if (dist < secondDist) {
+      secondDist = dist;
+    }
+  }
+
+  GlyphMatch m = { '?', 0 };
+  if (best < 0) return m;
+
+  // Хотя бы один сегмент уверенно против лучшего символа - это не он
+  for (int s = 0; s < segments; s++) {
+    int t = ((_masks[best] >> s) & 1) ? e[s] : -e[s];
+    if (t <= -SOFT_RANGE / 2) return m;
+  }
+
+  // Разрыв до второго кандидата: один сегмент, однозначно отличающий
+  // символы, даёт разрыв 2*SOFT_RANGE - это 100%
+  int gap = (secondDist == 0x7FFFFFFF) ? 2 * SOFT_RANGE : secondDist - bestDist;
+  int conf = gap * 100 / (2 * SOFT_RANGE);
+  m.symbol = _symbols[best];
+  m.confidence = (uint8_t)(conf > 100 ? 100 : conf);
+  return m;
+}
+
+void AutoThreshold::reset() {
+  memset(_hist, 0, sizeof(_hist));
+  _head = 0;
+  _filled = 0;
+}
+
+void AutoThreshold::add(const int *values, int count) {
+  for (int i = 0; i < count; i++) {
+    int v = values[i] < 0 ? 0 : (values[i] > 255 ? 255 : values[i]);
+    if (_filled == HISTORY) _hist[_ring[_head] >> 2]--;
+    else _filled++;
+    _ring[_head] = (uint8_t)v;
+    _hist[v >> 2]++;
+    _head = (_head + 1) % HISTORY;
+  }
+}
+
+int AutoThreshold::threshold(int fallback) const {
+  if (_filled < 2) return fallback;
+
+  uint32_t total = 0, sumAll = 0;
+  for (int b = 0; b < BINS; b++) {
+    total += _hist[b];
+    sumAll += (uint32_t)_hist[b] * b;
+  }
+
+  // Максимум межклассовой дисперсии w0*w1*(m0-m1)^2 без деления:
+  // (sumAll*w0 - sum0*total)^2 / (w0*w1), сравниваем в float
+  uint32_t w0 = 0, sum0 = 0;
+  float bestVar = 0;
+  int bestBin = -1;
+  for (int b = 0; b < BINS - 1; b++) {
+    w0 += _hist[b];
+    sum0 += (uint32_t)_hist[b] * b;
+    if (w0 == 0) continue;
+    uint32_t w1 = total - w0;
+    if (w1 == 0) break;
+    float d = (float)sumAll * w0 - (float)sum0 * total;
+    float var = d * d / ((float)w0 * w1);
+    if (var > bestVar) {
+      bestVar = var;
+      bestBin = b;
+    }
+  }
+  if (bestBin < 0) return fallback;
+
+  // Проверяем, что классы действительно разнесены
+  uint32_t c0 = 0, s0 = 0;
+  for (int b = 0; b <= bestBin; b++) { c0 += _hist[b]; s0 += (uint32_t)_hist[b] * b; }
+  uint32_t c1 = total - c0, s1 = sumAll - s0;
+  int m0 = (int)(s0 * 4 / c0), m1 = (int)(s1 * 4 / c1);
+  if (m1 - m0 < MIN_CONTRAST) return fallback;
+
+  // При чистом разрыве между классами максимум плоский по всему разрыву,
+  // поэтому берём середину между средними классов, а не границу бина
+  return (m0 + m1) / 2;
+}
+
+void BlinkDetector::begin(int leds, uint32_t holdMs) {
+  _count = leds < 0 ? 0 : (leds > MAX_LEDS ? MAX_LEDS : leds);
+  _holdMs = holdMs;
+  reset();
+}
+
+void BlinkDetector::reset() {
+  _started = false;
+  for (int i = 0; i < MAX_LEDS; i++) {
+    _leds[i] = Led{0, UNDECIDED, 0, 0, 0, 0, 0};
+  }
+}
+
+bool BlinkDetector::push(uint32_t now, const uint8_t *bits) {
+  bool changed = false;
+  for (int i = 0; i < _count; i++) {
+    Led &l = _leds[i];
+    uint8_t b = bits[i] ? 1 : 0;
+    uint8_t oldMode = l.mode;
+
+    if (!_started) {
+      l.state = b;
+      l.lastChange = now;
+      continue;
+    }
+
+    if (b != l.state) {
+      l.state = b;
+      l.lastChange = now;
+      if (b) {
+        uint32_t interval = now - l.lastRise;
+        if (l.rises == 0) {
+          l.rises = 1;  // первое включение - только точка отсчёта
+        } else if (l.rises == 1 || (interval * 2 > l.period && interval < l.period * 2)) {
+          // Первый интервал принимаем как есть, дальше - только похожие
+          l.period = (l.rises == 1) ? interval : (l.period * 3 + interval) / 4;
+          if (l.rises < 255) l.rises++;
+        } else {
+          // Выброс (шумный кадр) - начинаем набор заново
+          l.rises = 1;
+        }
+        l.lastRise = now;
+        if (l.rises >= 4) l.mode = LED_BLINK;
+      }
+    } else if (now - l.lastChange > _holdMs) {
+      l.mode = l.state ? LED_ON : LED_OFF;
+      l.rises = 0;
+      l.period = 0;
+    }
+
+    if (l.mode != oldMode) {
+      l.reported = l.period;
+      changed = true;
+    } else if (l.mode == LED_BLINK) {
+      uint32_t d = l.period > l.reported ? l.period - l.reported : l.reported - l.period;
+      if (d * 8 > l.reported) { l.reported = l.period; changed = true; }
+    }
+  }
+  _started = true;
+  return changed;
+}
+
+bool BlinkDetector::ready() const {
+  for (int i = 0; i < _count; i++) {
+    if (_leds[i].mode == UNDECIDED) return false;
+  }
+  return true;
+}
@@ -0,0 +1,165 @@
+#ifndef DIGIT_DECODER_H
+#define DIGIT_DECODER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Голосование по последним depth кадрам. Для каждого прямоугольника
+// разметки (сегмента или LED) хранятся средняя яркость и бит "горит".
+// Устойчивый бит меняется, только когда за новое значение не меньше
+// agree кадров окна, так что одиночный шумный кадр ничего не переключает.
+class TemporalVoter {
+ public:
+  ~TemporalVoter();
+
+  // rects - число прямоугольников, depth - глубина окна (до 15),
+  // agree - сколько кадров окна должны совпасть для смены состояния
+  bool begin(int rects, int depth, int agree);
+
+  // Сброс истории (после смены ROI, разметки или формата)
+  void reset();
+
+  // Кадр: bits[i] = 0/1, means[i] - средняя яркость
+  void push(const uint8_t *bits, const int *means);
+
+  // Окно заполнено и устойчивые биты определены
+  bool ready() const { return _filled >= _depth; }
+
+  // Окно заполнено и последний кадр совпадает с устойчивым состоянием -
+  // новые одинаковые кадры ничего не изменят
+  bool settled() const;
+
+  // Медиана яркости прямоугольника по окну
+  int medianMean(int rect) const;
+
+  int depth() const { return _depth; }
+  int count() const { return _rects; }
+
+ private:
+  uint8_t *_bits = nullptr;    // depth x rects
+  uint8_t *_means = nullptr;   // depth x rects
+  uint8_t *_stable = nullptr;  // rects
+  int _rects = 0;
+  int _depth = 0;
+  int _agree = 0;
+  int _head = 0;
+  int _filled = 0;
+};
+
+// Детектор изменений кадра по эскизу - вектору средних яркостей
+// прямоугольников разметки. Кадр считается изменённым, если хотя бы одно
+// значение ушло от опорного дальше допуска; тогда эскиз становится новым
+// опорным. Медленный дрейф освещения в пределах допуска не мешает.
+class ChangeDetector {
+ public:
+  ~ChangeDetector();
+  bool begin(int count);
+  // Следующий кадр будет считаться изменённым
+  void reset() { _valid = false; }
+  bool changed(const int *sketch, int tolerance);
+
+ private:
+  int16_t *_ref = nullptr;
+  int _count = 0;
+  bool _valid = false;
+};
+
+// Результат мягкой классификации цифры
+struct GlyphMatch {
+  char symbol;         // '?' - ничего похожего
+  uint8_t confidence;  // 0..100: насколько лучший символ отстоит от второго
+};
+
+// Классификатор символа семисегментного индикатора по средним яркостям
+// сегментов. Вместо точного совпадения 7-битной маски каждый символ
+// получает взвешенное расстояние: сегмент вносит тем больше, чем дальше
+// его яркость от порога в "неправильную" сторону. Сегмент у самого порога
+// почти ничего не решает, а лишь снижает уверенность.
+class GlyphClassifier {
+ public:
+  static const int MAX_GLYPHS = 32;
+  static const int SOFT_RANGE = 40;  // яркость, при которой сегмент считается однозначным
+
+  void clear() { _count = 0; }
+  // mask - биты сегментов (бит s - сегмент s)
+  bool addGlyph(uint32_t mask, char symbol);
+
+  // means[0..segments-1] - яркости сегментов одной цифры
+  GlyphMatch classify(const int *means, int segments, int threshold) const;
+
+  int count() const { return _count; }
+
+ private:
+  uint32_t _masks[MAX_GLYPHS];
+  char _symbols[MAX_GLYPHS];
+  int _count = 0;
+};
+
+// Автоматический порог по гистограмме средних яркостей (метод Otsu).
+// Гистограмма ведётся инкрементально по скользящему окну из последних
+// HISTORY значений, так что пересчёт порога - один проход по 64 бинам.
+// Если распределение не делится на два явных класса (например, горят
+// все сегменты), возвращается заданный вручную порог.
+class AutoThreshold {
+ public:
+  static const int BINS = 64;          // по 4 уровня яркости на бин
+  static const int HISTORY = 256;      // значений в скользящем окне
+  static const int MIN_CONTRAST = 30;  // минимальный разрыв между средними классов
+
+  void reset();
+  void add(const int *values, int count);
+
+  // Порог Otsu либо fallback, если разделить не получилось
+  int threshold(int fallback) const;
+
+ private:
+  uint16_t _hist[BINS] = {0};
+  uint8_t _ring[HISTORY];
+  int _head = 0;
+  int _filled = 0;
+};
+
+// Режим светодиода по частой выборке
+enum LedMode : uint8_t { LED_OFF = 0, LED_ON, LED_BLINK };
+
+// Детектор мигания светодиодов. Светодиод считается мигающим, когда подряд
+// пришли три интервала между включениями, близкие друг к другу (не дальше
+// чем вдвое), и горящим/погасшим - когда его состояние не
+// менялось дольше holdMs. Период - скользящее среднее интервалов между
+// включениями. Время - millis(), переполнение учитывается.
+class BlinkDetector {
+ public:
+  static const int MAX_LEDS = 16;
+
+  void begin(int leds, uint32_t holdMs);
+  void reset();
+
+  // bits[i] - горит ли светодиод i на кадре момента now.
+  // true - режим или период хотя бы одного светодиода изменился
+  bool push(uint32_t now, const uint8_t *bits);
+
+  // Все светодиоды уже получили режим
+  bool ready() const;
+  LedMode mode(int led) const { return (LedMode)_leds[led].mode; }
+  // Последний сообщённый период (меняется, только когда оценка ушла больше чем на 1/8)
+  uint32_t periodMs(int led) const { return _leds[led].mode == LED_BLINK ? _leds[led].reported : 0; }
+  int count() const { return _count; }
+
+ private:
+  static const uint8_t UNDECIDED = 0xFF;
+  struct Led {
+    uint8_t state;
+    uint8_t mode;
+    uint8_t rises;        // подряд согласованных интервалов
+    uint32_t lastChange;
+    uint32_t lastRise;
+    uint32_t period;
+    uint32_t reported;
+  };
+  Led _leds[MAX_LEDS];
+  int _count = 0;
+  uint32_t _holdMs = 2500;
+  bool _started = false;
+};
+
+#endif
@@ -0,0 +1,80 @@
+#include "DisplayProfile.h"
+#include <stdlib.h>
+#include <string.h>
+
+DisplayLayout::~DisplayLayout() {
+  free(_arena);
+}
+
+bool DisplayLayout::configure(const PanelProfile *panels, int count) {
+  if (count < 1 || count > PROFILE_MAX_PANELS) return false;
+
+  PanelProfile next[PROFILE_MAX_PANELS];
+  int digits = 0, leds = 0, points = 0;
+  for (int p = 0; p < count; p++) {
+    next[p] = panels[p];
+    next[p].name[PROFILE_NAME_LEN - 1] = 0;
+    if (!next[p].name[0]) return false;
+    for (int q = 0; q < p; q++) {
+      if (strcmp(next[q].name, next[p].name) == 0) return false;
+    }
+    next[p].firstDigit = (uint8_t)digits;
+    next[p].firstLed = (uint8_t)leds;
+    digits += next[p].digits;
+    leds += next[p].leds;
+    if (next[p].decimalPoints) points += next[p].digits;
+  }
+  if (digits > PROFILE_MAX_DIGITS || leds > PROFILE_MAX_LEDS) return false;
+
+  int total = digits * PROFILE_SEGMENTS + points + leds;
+  Rect *arena = (Rect*)calloc(total > 0 ? total : 1, sizeof(Rect));
+  if (!arena) return false;
+
+  int16_t pointIndex[PROFILE_MAX_DIGITS];
+  int pointBase = digits * PROFILE_SEGMENTS;
+  int ledBase = pointBase + points;
+  int pt = 0;
+  for (int p = 0; p < count; p++) {
+    for (int d = 0; d < next[p].digits; d++) {
+      pointIndex[next[p].firstDigit + d] = next[p].decimalPoints ? (int16_t)(pointBase + pt++) : -1;
+    }
+  }
+
+  // Панели с тем же именем сохраняют разметку: смена числа цифр одной
+  // панели не сбрасывает остальные
+  for (int p = 0; p < count; p++) {
+    const PanelProfile *old = nullptr;
+    for (int q = 0; q < _panelCount; q++) {
+      if (strcmp(_panels[q].name, next[p].name) == 0) { old = &_panels[q]; break; }
+    }
+    if (!old) continue;
+    int nd = next[p].digits < old->digits ? next[p].digits : old->digits;
+    for (int d = 0; d < nd; d++) {
+      int from = old->firstDigit + d, to = next[p].firstDigit + d;
+      memcpy(&arena[to * PROFILE_SEGMENTS], &_arena[from * PROFILE_SEGMENTS],
+             PROFILE_SEGMENTS * sizeof(Rect));
+      if (pointIndex[to] >= 0 && _pointIndex[from] >= 0) arena[pointIndex[to]] = _arena[_pointIndex[from]];
+    }
+    int nl = next[p].leds < old->leds ? next[p].leds : old->leds;
+    for (int i = 0; i < nl; i++) {
+      arena[ledBase + next[p].firstLed + i] = _arena[digitRectCount() + old->firstLed + i];
+    }
+  }
+
+  free(_arena);
+  _arena = arena;
+  memcpy(_panels, next, sizeof(PanelProfile) * count);
+  memcpy(_pointIndex, pointIndex, sizeof(int16_t) * digits);
+  _panelCount = count;
+  _digits = digits;
+  _leds = leds;
+  _points = points;
+  return true;
+}
+
+int DisplayLayout::panelOfDigit(int d) const {
+  for (int p = _panelCount - 1; p > 0; p--) {
+    if (d >= _panels[p].firstDigit) return p;
+  }
+  return 0;
+}
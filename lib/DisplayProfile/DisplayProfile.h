@@ -0,0 +1,80 @@
+#ifndef DISPLAY_PROFILE_H
+#define DISPLAY_PROFILE_H
+
+#include <stdint.h>
+#include "LumaSampler.h"
+
+// Профили индикаторов: сколько цифр, светодиодов и есть ли десятичные точки
+// у каждой панели. Все прямоугольники разметки лежат в одной арене подряд:
+//   [сегменты всех цифр, по 7 на цифру][точки цифр, у которых они есть][светодиоды]
+// Первые две части вместе - план выборки цифр, последняя - план светодиодов,
+// так что их можно отдавать в SamplingPlan без копирования. Память
+// выделяется только при смене профиля, на кадре ничего не выделяется.
+// Пределы - общие на все панели: чтения с такими размерами ходят через
+// очередь FreeRTOS фиксированного размера. Без Arduino.
+
+const int PROFILE_MAX_PANELS = 4;
+const int PROFILE_MAX_DIGITS = 16;
+const int PROFILE_MAX_LEDS = 16;
+const int PROFILE_SEGMENTS = 7;
+const int PROFILE_NAME_LEN = 16;
+// Сегменты и точки всех цифр
+const int PROFILE_MAX_DIGIT_RECTS = PROFILE_MAX_DIGITS * (PROFILE_SEGMENTS + 1);
+
+struct PanelProfile {
+  char name[PROFILE_NAME_LEN];
+  uint8_t digits;
+  uint8_t leds;
+  bool decimalPoints;
+  // Заполняются DisplayLayout::configure(): первая цифра и первый светодиод
+  // панели в сквозной нумерации
+  uint8_t firstDigit;
+  uint8_t firstLed;
+};
+
+class DisplayLayout {
+ public:
+  DisplayLayout() {}
+  ~DisplayLayout();
+  DisplayLayout(const DisplayLayout &) = delete;
+  DisplayLayout &operator=(const DisplayLayout &) = delete;
+
+  // Новый набор панелей. Прямоугольники панелей с тем же именем переносятся
+  // из текущей разметки (сколько влезает), остальные обнуляются.
+  // false - превышены пределы, пустое имя или не хватило памяти; тогда
+  // разметка остаётся прежней
+  bool configure(const PanelProfile *panels, int count);
+
+  int panelCount() const { return _panelCount; }
+  const PanelProfile &panel(int p) const { return _panels[p]; }
+  int digitCount() const { return _digits; }
+  int ledCount() const { return _leds; }
+  int pointCount() const { return _points; }
+
+  // Сегмент s цифры d (сквозная нумерация цифр по панелям)
+  Rect &segment(int d, int s) { return _arena[d * PROFILE_SEGMENTS + s]; }
+  const Rect &segment(int d, int s) const { return _arena[d * PROFILE_SEGMENTS + s]; }
+  // Номер прямоугольника точки цифры d среди digitRects(), -1 - точки нет
+  int pointIndex(int d) const { return _pointIndex[d]; }
+  Rect &led(int i) { return _arena[digitRectCount() + i]; }
+  const Rect &led(int i) const { return _arena[digitRectCount() + i]; }
+
+  // Сплошные куски арены для планов выборки
+  const Rect *digitRects() const { return _arena; }
+  int digitRectCount() const { return _digits * PROFILE_SEGMENTS + _points; }
+  const Rect *ledRects() const { return _arena + digitRectCount(); }
+  Rect *rects() { return _arena; }
+  int rectCount() const { return digitRectCount() + _leds; }
+
+  // Панель, которой принадлежит цифра d
+  int panelOfDigit(int d) const;
+
+ private:
+  PanelProfile _panels[PROFILE_MAX_PANELS];
+  int _panelCount = 0;
+  int _digits = 0, _leds = 0, _points = 0;
+  int16_t _pointIndex[PROFILE_MAX_DIGITS];
+  Rect *_arena = nullptr;
+};
+
+#endif
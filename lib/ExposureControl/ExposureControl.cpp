@@ -0,0 +1,121 @@
+#include "ExposureControl.h"
+
+static int clampInt(int v, int lo, int hi) {
+  return v < lo ? lo : (v > hi ? hi : v);
+}
+
+void ExposureControl::begin(int exposure, int gain, const Limits &limits) {
+  _limits = limits;
+  _exposure = clampInt(exposure, limits.exposureMin, limits.exposureMax);
+  _gain = clampInt(gain, limits.gainMin, limits.gainMax);
+  _changed = false;
+  _adjustments = 0;
+  unfreeze();
+}
+
+void ExposureControl::unfreeze() {
+  _frozen = false;
+  _hits = 0;
+  _misses = 0;
+}
+
+bool ExposureControl::apply(int exposure, int gain, uint32_t now) {
+  exposure = clampInt(exposure, _limits.exposureMin, _limits.exposureMax);
+  gain = clampInt(gain, _limits.gainMin, _limits.gainMax);
+  if (exposure == _exposure && gain == _gain) return false;
+  _exposure = exposure;
+  _gain = gain;
+  _lastChange = now;
+  _changed = true;
+  _adjustments++;
+  return true;
+}
+
+// Порог Otsu по отсортированным значениям v[0..n-1]: средние нижнего и
+// верхнего класса. Одно значение - оба класса из него
+static void splitOtsu(const int *v, int n, int &low, int &high) {
+  int64_t total = 0;
+  for (int i = 0; i < n; i++) total += v[i];
+  low = high = (int)(total / n);
+  int64_t best = -1, sumLow = 0;
+  for (int k = 1; k < n; k++) {
+    sumLow += v[k - 1];
+    int64_t mLow = sumLow / k, mHigh = (total - sumLow) / (n - k);
+    int64_t between = (int64_t)k * (n - k) * (mHigh - mLow) * (mHigh - mLow);
+    if (between > best) {
+      best = between;
+      low = (int)mLow;
+      high = (int)mHigh;
+    }
+  }
+}
+
+bool ExposureControl::update(uint32_t now, uint32_t frameTime, const int *means, int count) {
+  // Кадр снят до того, как сенсор успел применить прошлое изменение
+  if (_changed && (int32_t)(frameTime - _lastChange) < (int32_t)SETTLE_MS) return false;
+  if (count <= 0) return false;
+  if (count > MAX_MEANS) count = MAX_MEANS;
+
+  int v[MAX_MEANS];
+  int64_t total = 0;
+  for (int i = 0; i < count; i++) {
+    int x = clampInt(means[i], 0, 255);
+    int j = i;
+    while (j > 0 && v[j - 1] > x) { v[j] = v[j - 1]; j--; }
+    v[j] = x;
+    total += x;
+  }
+  int dark, bright;
+  splitOtsu(v, count, dark, bright);
+  _mean = (int)(total / count);
+  _bright = bright;
+  _contrast = bright - dark;
+
+  // Горящие не отделяются (тёмная комната, пустой или целиком горящий
+  // дисплей) - поднимаем среднюю яркость сегментов хотя бы до
+  // SEARCH_TARGET, чтобы разница стала видна; ярче - уже не повод темнить,
+  // кроме насыщения. Выход из поиска по MIN_CONTRAST, возврат - по 2/3 от
+  // него, чтобы режим не дёргался на границе. Смена режима снимает заморозку
+  bool searching = _searching ? _contrast < MIN_CONTRAST : _contrast < MIN_CONTRAST * 2 / 3;
+  if (searching != _searching) {
+    _searching = searching;
+    unfreeze();
+  }
+  int level = searching ? _mean : bright;
+  int target = searching ? SEARCH_TARGET : TARGET;
+
+  int err = level - target;
+  if (searching && err > 0 && level < SATURATED) err = 0;
+  if (err < 0) err = -err;
+  if (_frozen) {
+    _misses = (err > WAKE_DELTA) ? _misses + 1 : 0;
+    if (_misses < WAKE_FRAMES) return false;
+    unfreeze();
+  }
+  if (err <= TOLERANCE) {
+    if (++_hits >= CONFIRM_FRAMES) _frozen = true;
+    return false;
+  }
+  _hits = 0;
+
+  // Насыщение скрывает настоящую яркость - просто вдвое темнее
+  if (level >= SATURATED) {
+    if (_gain > _limits.gainMin) return apply(_exposure, _gain / 2, now);
+    return apply(_exposure / 2, _gain, now);
+  }
+
+  int b = level < 8 ? 8 : level;
+  if (b < target) {
+    // Темно: сначала экспозиция (не больше чем вдвое за шаг), потом усиление
+    int e = _exposure * target / b;
+    if (e > _exposure * 2) e = _exposure * 2;
+    if (_exposure < _limits.exposureMax) return apply(e, _gain, now);
+    return apply(_exposure, _gain + 2, now);
+  }
+  // Светло: сначала убираем усиление, потом экспозицию (не меньше чем вдвое)
+  if (_gain > _limits.gainMin) return apply(_exposure, _gain - 2, now);
+  int e = _exposure * target / b;
+  if (e < _exposure / 2) e = _exposure / 2;
+  if (e == _exposure) e--;
+  return apply(e, _gain, now);
+}
@@ -0,0 +1,70 @@
+#ifndef EXPOSURE_CONTROL_H
+#define EXPOSURE_CONTROL_H
+
+#include <stdint.h>
+
+// Замкнутая регулировка экспозиции и усиления по яркости сегментов ROI
+// (а не всей сцены, как встроенные AEC/AGC сенсора). Средние яркости
+// сегментов делятся на горящие и погасшие порогом Otsu по ним самим, а не
+// порогом распознавания: если сегменты разделяются (контраст не меньше
+// MIN_CONTRAST), цель - яркость горящих, иначе - средняя яркость ROI, пока
+// горящие не станут видны. Экспозиция меняется пропорционально отношению
+// цели к текущей яркости, усиление - только когда экспозиция упёрлась в
+// предел. Когда яркость несколько кадров подряд держится в допуске,
+// регулировка замирает и не трогает сенсор, пока яркость надолго не уйдёт
+// за широкую границу. Без Arduino.
+class ExposureControl {
+ public:
+  static const int TARGET = 205;        // цель для горящих сегментов: ниже насыщения, выше порогов
+  static const int TOLERANCE = 15;      // в пределах - считаем попаданием (190..220 - выше порога 180)
+  static const int SEARCH_TARGET = 110; // цель для среднего ROI, пока горящие не отделяются
+  static const int MIN_CONTRAST = 30;   // разрыв между горящими и погасшими, при котором их видно
+  static const int WAKE_DELTA = 45;     // дальше - повод выйти из заморозки
+  static const int CONFIRM_FRAMES = 3;  // попаданий подряд до заморозки
+  static const int WAKE_FRAMES = 5;     // промахов подряд до разморозки
+  static const int SATURATED = 250;
+  static const int MAX_MEANS = 128;     // больше сегментов в измерение не попадает
+  static const uint32_t SETTLE_MS = 200;  // кадры моложе этого после изменения не учитываются
+
+  struct Limits {
+    int exposureMin = 1, exposureMax = 1200;
+    int gainMin = 0, gainMax = 30;
+  };
+
+  // Старт с текущих значений сенсора
+  void begin(int exposure, int gain, const Limits &limits);
+  void unfreeze();
+
+  // Измерение по кадру, снятому в frameTime (millis): means[0..count-1] -
+  // средние яркости сегментов. true - exposure()/gain() изменились и их
+  // нужно применить к сенсору
+  bool update(uint32_t now, uint32_t frameTime, const int *means, int count);
+
+  int exposure() const { return _exposure; }
+  int gain() const { return _gain; }
+  bool frozen() const { return _frozen; }
+  int bright() const { return _bright; }
+  int contrast() const { return _contrast; }
+  int mean() const { return _mean; }
+  bool searching() const { return _searching; }
+  uint32_t adjustments() const { return _adjustments; }
+
+ private:
+  bool apply(int exposure, int gain, uint32_t now);
+
+  Limits _limits;
+  int _exposure = 300;
+  int _gain = 0;
+  bool _frozen = false;
+  int _hits = 0;
+  int _misses = 0;
+  int _bright = -1;
+  int _contrast = 0;
+  int _mean = -1;
+  bool _searching = false;
+  uint32_t _lastChange = 0;
+  bool _changed = false;
+  uint32_t _adjustments = 0;
+};
+
+#endif
@@ -0,0 +1,89 @@
+#include "FrameBroker.h"
+#include "freertos/FreeRTOS.h"
+
+static const int MAX_SLOTS = 4;
+
+static FrameSlot g_slots[MAX_SLOTS];
+static int g_slotCount = 0;
+static FrameSlot *g_latest = nullptr;   // брокер держит на нём одну ссылку
+static uint32_t g_seq = 0;
+static uint32_t g_dropped = 0;
+static portMUX_TYPE g_mux = portMUX_INITIALIZER_UNLOCKED;
+
+FrameRef &FrameRef::operator=(FrameRef &&o) {
+  if (this != &o) {
+    release();
+    _slot = o._slot;
+    o._slot = nullptr;
+  }
+  return *this;
+}
+
+void FrameRef::release() {
+  if (!_slot) return;
+  portENTER_CRITICAL(&g_mux);
+  _slot->refs--;
+  portEXIT_CRITICAL(&g_mux);
+  _slot = nullptr;
+}
+
+bool FrameBroker::begin(int slots, size_t slotBytes) {
+  if (g_slotCount) return true; // already started
+  if (slots < 2) slots = 2;
+  if (slots > MAX_SLOTS) slots = MAX_SLOTS;
+  for (int i = 0; i < slots; i++) {
+    uint8_t *p = (uint8_t*)(psramFound() ? ps_malloc(slotBytes) : malloc(slotBytes));
+    if (!p) break;
+    g_slots[i].buf = p;
+    g_slots[i].capacity = slotBytes;
+    g_slots[i].len = 0;
+    g_slots[i].refs = 0;
+    g_slotCount = i + 1;
+  }
+  return g_slotCount >= 2;
+}
+
+bool FrameBroker::publish(const camera_fb_t *fb, uint32_t timestamp) {
+  if (!fb || fb->len == 0) return false;
+
+  // Свободный слот: на него никто не ссылается (включая сам брокер)
+  FrameSlot *slot = nullptr;
+  portENTER_CRITICAL(&g_mux);
+  for (int i = 0; i < g_slotCount; i++) {
+    if (g_slots[i].refs == 0 && g_slots[i].capacity >= fb->len) {
+      slot = &g_slots[i];
+      slot->refs = 1;  // ссылка брокера, пока пишем и пока слот последний
+      break;
+    }
+  }
+  if (!slot) g_dropped++;
+  portEXIT_CRITICAL(&g_mux);
+  if (!slot) return false;
+
+  memcpy(slot->buf, fb->buf, fb->len);
+  slot->len = fb->len;
+  slot->width = fb->width;
+  slot->height = fb->height;
+  slot->format = fb->format;
+  slot->timestamp = timestamp;
+
+  portENTER_CRITICAL(&g_mux);
+  slot->seq = ++g_seq;
+  FrameSlot *prev = g_latest;
+  g_latest = slot;
+  if (prev) prev->refs--;
+  portEXIT_CRITICAL(&g_mux);
+  return true;
+}
+
+FrameRef FrameBroker::latest() {
+  FrameSlot *slot;
+  portENTER_CRITICAL(&g_mux);
+  slot = g_latest;
+  if (slot) slot->refs++;
+  portEXIT_CRITICAL(&g_mux);
+  return FrameRef(slot);
+}
+
+uint32_t FrameBroker::captures() { return g_seq; }
+uint32_t FrameBroker::dropped() { return g_dropped; }
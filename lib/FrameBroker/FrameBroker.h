@@ -0,0 +1,65 @@
+#ifndef FRAME_BROKER_H
+#define FRAME_BROKER_H
+
+#include <Arduino.h>
+#include "esp_camera.h"
+
+// Кадр, захваченный один раз и разделяемый между потребителями
+// (распознавание, просмотр /frame, запись). Сам буфер камеры
+// возвращается драйверу сразу после копирования в слот.
+struct FrameSlot {
+  uint8_t *buf;
+  size_t len;
+  size_t capacity;
+  int width;
+  int height;
+  pixformat_t format;
+  uint32_t seq;         // порядковый номер кадра
+  uint32_t timestamp;   // millis() момента захвата
+  volatile int refs;
+};
+
+// Ссылка только для чтения на кадр в слоте; пока она жива, слот не
+// перезаписывается. Только перемещение, без копирования.
+class FrameRef {
+ public:
+  FrameRef() {}
+  explicit FrameRef(FrameSlot *slot) : _slot(slot) {}
+  FrameRef(FrameRef &&o) : _slot(o._slot) { o._slot = nullptr; }
+  FrameRef &operator=(FrameRef &&o);
+  FrameRef(const FrameRef &) = delete;
+  FrameRef &operator=(const FrameRef &) = delete;
+  ~FrameRef() { release(); }
+
+  void release();
+  explicit operator bool() const { return _slot != nullptr; }
+
+  const uint8_t *buf() const { return _slot->buf; }
+  size_t len() const { return _slot->len; }
+  int width() const { return _slot->width; }
+  int height() const { return _slot->height; }
+  pixformat_t format() const { return _slot->format; }
+  uint32_t seq() const { return _slot->seq; }
+  uint32_t timestamp() const { return _slot->timestamp; }
+
+ private:
+  FrameSlot *_slot = nullptr;
+};
+
+namespace FrameBroker {
+  // slots - число слотов (не меньше 2), slotBytes - размер самого большого кадра.
+  // Слоты выделяются в PSRAM, если она есть
+  bool begin(int slots, size_t slotBytes);
+
+  // Копирует кадр камеры в свободный слот и делает его последним.
+  // false - все слоты заняты читателями или кадр не помещается
+  bool publish(const camera_fb_t *fb, uint32_t timestamp);
+
+  // Последний опубликованный кадр (пустая ссылка, если кадров ещё не было)
+  FrameRef latest();
+
+  uint32_t captures();   // сколько кадров опубликовано
+  uint32_t dropped();    // сколько кадров не нашло свободного слота
+}
+
+#endif
@@ -0,0 +1,325 @@
+#include "FrameCodec.h"
+#include <string.h>
+
+static void putBE32(uint8_t *p, uint32_t v) {
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+
+// ====================== QOI ======================
+bool QoiEncoder::begin(int width, int height, int channels) {
+  _ok = width > 0 && height > 0 && (channels == 1 || channels == 3);
+  if (!_ok) return false;
+  _bytes = 0;
+  _len = 0;
+  _width = width;
+  _channels = channels;
+  // Индекс декодера стартует с нулей при альфе 0, а все наши точки
+  // непрозрачны - пустой слот ни с чем не совпадёт
+  memset(_index, 0, sizeof(_index));
+  memset(_valid, 0, sizeof(_valid));
+  _prev[0] = _prev[1] = _prev[2] = 0;
+  _run = 0;
+
+  uint8_t header[14] = { 'q', 'o', 'i', 'f' };
+  putBE32(header + 4, (uint32_t)width);
+  putBE32(header + 8, (uint32_t)height);
+  header[12] = 3;   // RGB
+  header[13] = 0;   // sRGB
+  for (int i = 0; i < 14; i++) put(header[i]);
+  return _ok;
+}
+
+bool QoiEncoder::writeRow(const uint8_t *pixels) {
+  if (!_ok) return false;
+  if (_channels == 3) {
+    for (int x = 0; x < _width; x++, pixels += 3) pixel(pixels[0], pixels[1], pixels[2]);
+  } else {
+    for (int x = 0; x < _width; x++) pixel(pixels[x], pixels[x], pixels[x]);
+  }
+  return _ok;
+}
+
+void QoiEncoder::pixel(uint8_t r, uint8_t g, uint8_t b) {
+  if (r == _prev[0] && g == _prev[1] && b == _prev[2]) {
+    if (++_run == 62) flushRun();
+    return;
+  }
+  flushRun();
+
+  int h = (r * 3 + g * 5 + b * 7 + 255 * 11) & 63;
+  if (_valid[h] && _index[h][0] == r && _index[h][1] == g && _index[h][2] == b) {
+    put((uint8_t)h);                                   // QOI_OP_INDEX
+  } else {
+    _index[h][0] = r;
+    _index[h][1] = g;
+    _index[h][2] = b;
+    _valid[h] = true;
+    int dr = (int8_t)(r - _prev[0]);
+    int dg = (int8_t)(g - _prev[1]);
+    int db = (int8_t)(b - _prev[2]);
+    int drg = dr - dg, dbg = db - dg;
+    if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+      put((uint8_t)(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));   // QOI_OP_DIFF
+    } else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7) {
+      put((uint8_t)(0x80 | (dg + 32)));                // QOI_OP_LUMA
+      put((uint8_t)((drg + 8) << 4 | (dbg + 8)));
+    } else {
+      put(0xFE);                                       // QOI_OP_RGB
+      put(r);
+      put(g);
+      put(b);
+    }
+  }
+  _prev[0] = r;
+  _prev[1] = g;
+  _prev[2] = b;
+}
+
+void QoiEncoder::flushRun() {
+  if (!_run) return;
+  put((uint8_t)(0xC0 | (_run - 1)));                   // QOI_OP_RUN
+  _run = 0;
+}
+
+bool QoiEncoder::end() {
+  if (!_ok) return false;
+  flushRun();
+  static const uint8_t PADDING[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+  for (int i = 0; i < 8; i++) put(PADDING[i]);
+  flush();
+  return _ok;
+}
+
+void QoiEncoder::flush() {
+  if (_ok && _len && _writer(_arg, _buf, _len) != _len) _ok = false;
+  _bytes += _len;
+  _len = 0;
+}
+
+// ====================== PNG ======================
+// CRC-32 по полубайтам: таблица на 64 байта вместо килобайта
+static const uint32_t CRC_NIBBLE[16] = {
+  0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+  0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+static uint32_t crc32Update(uint32_t crc, const uint8_t *p, size_t len) {
+  while (len--) {
+    crc ^= *p++;
+    crc = (crc >> 4) ^ CRC_NIBBLE[crc & 15];
+    crc = (crc >> 4) ^ CRC_NIBBLE[crc & 15];
+  }
+  return crc;
+}
+
+// Длины совпадений deflate: начало диапазона каждого кода 257..285 и
+// число дополнительных бит
+static const uint16_t LENGTH_BASE[29] = {
+  3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t LENGTH_EXTRA[29] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+// Длины кодов литералов и длин совпадений (0..285) для единственного блока.
+// Блок формально динамический, но таблица постоянная и пишется в заголовок
+// как есть, так что кодер по-прежнему однопроходный. Длины - код Хаффмана
+// по частотам разностей после Sub на кадрах камеры (светлые сегменты на
+// тёмном фоне с шумом, серые и RGB565, расширенные до RGB888), симметричных
+// по знаку и сглаженных, плюс доля равномерного шума: малая разность - 2..6
+// бит, любой байт - не больше 13 бит. У фиксированного кода отрицательная
+// разность стоила 9 бит, и зашумлённый кадр выходил не меньше BMP
+static const uint8_t LIT_LENGTHS[286] = {
+  2, 4, 4, 5, 5, 6, 6, 7, 5, 7, 8, 8, 9, 9, 9, 10,
+  10, 10, 10, 10, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 12,
+  11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+  11, 11, 11, 11, 11, 11, 11, 11, 12, 12, 12, 12, 12, 12, 12, 12,
+  11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+  11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+  12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+  12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+  13, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+  12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+  12, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+  11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+  11, 12, 12, 12, 12, 12, 12, 12, 12, 11, 11, 11, 11, 11, 11, 11,
+  11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+  11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 10, 10, 10,
+  10, 10, 9, 9, 9, 8, 8, 7, 5, 7, 6, 6, 4, 5, 4, 4,
+  13, 8, 7, 9, 9, 8, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9,
+  9, 9, 9, 9, 9, 9, 10, 10, 9, 9, 9, 9, 9, 9
+};
+
+// Канонические коды для LIT_LENGTHS (RFC 1951, 3.2.2), старшим битом вперёд
+static uint16_t litCodes[286];
+static bool litCodesReady = false;
+
+static void buildLitCodes() {
+  int count[16] = { 0 };
+  for (int s = 0; s < 286; s++) count[LIT_LENGTHS[s]]++;
+  uint16_t next[16];
+  uint16_t code = 0;
+  count[0] = 0;
+  for (int len = 1; len < 16; len++) {
+    code = (uint16_t)((code + count[len - 1]) << 1);
+    next[len] = code;
+  }
+  for (int s = 0; s < 286; s++) litCodes[s] = next[LIT_LENGTHS[s]]++;
+  litCodesReady = true;
+}
+
+static const uint32_t ADLER_MOD = 65521;
+static const int ADLER_NMAX = 5552;   // столько байт без переполнения 32 бит
+
+bool PngEncoder::begin(int width, int height, int channels) {
+  _ok = width > 0 && height > 0 && (channels == 1 || channels == 3);
+  if (!_ok) return false;
+  _bytes = 0;
+  _len = 0;
+  _width = width;
+  _channels = channels;
+  _adlerA = 1;
+  _adlerB = 0;
+  _adlerPending = 0;
+  _havePrev = false;
+  _run = 0;
+  _bitBuf = 0;
+  _bitCount = 0;
+
+  static const uint8_t SIGNATURE[8] = { 137, 'P', 'N', 'G', '\r', '\n', 26, '\n' };
+  write(SIGNATURE, sizeof(SIGNATURE));
+
+  uint8_t ihdr[13];
+  putBE32(ihdr, (uint32_t)width);
+  putBE32(ihdr + 4, (uint32_t)height);
+  ihdr[8] = 8;                         // бит на канал
+  ihdr[9] = channels == 3 ? 2 : 0;     // RGB или серый
+  ihdr[10] = ihdr[11] = ihdr[12] = 0;  // deflate, обычные фильтры, без чересстрочности
+  chunk("IHDR", ihdr, sizeof(ihdr));
+
+  // zlib: окно 32K, без словаря; один последний блок с таблицей LIT_LENGTHS
+  putByte(0x78);
+  putByte(0x01);
+  if (!litCodesReady) buildLitCodes();
+  bits(1, 1);
+  bits(2, 2);                 // динамический код
+  bits(286 - 257, 5);         // HLIT: все коды литералов и длин
+  bits(1 - 1, 5);             // HDIST: один код расстояния
+  bits(19 - 4, 4);            // HCLEN: все коды длин кодов
+  // Код длин кодов: символы 0..15 по 4 бита, повторы 16..18 не нужны.
+  // Порядок - из RFC 1951, 3.2.7
+  static const uint8_t CL_ORDER[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+  for (int i = 0; i < 19; i++) bits(CL_ORDER[i] <= 15 ? 4 : 0, 3);
+  for (int s = 0; s < 286; s++) code(LIT_LENGTHS[s], 4);
+  code(1, 4);                 // расстояние 1 - единственный код длиной 1 бит
+  return _ok;
+}
+
+bool PngEncoder::writeRow(const uint8_t *pixels) {
+  if (!_ok) return false;
+  data(1);   // фильтр Sub
+  int rowBytes = _width * _channels;
+  for (int i = 0; i < _channels; i++) data(pixels[i]);
+  for (int i = _channels; i < rowBytes; i++) data((uint8_t)(pixels[i] - pixels[i - _channels]));
+  return _ok;
+}
+
+void PngEncoder::data(uint8_t b) {
+  _adlerA += b;
+  _adlerB += _adlerA;
+  if (++_adlerPending == ADLER_NMAX) {
+    _adlerA %= ADLER_MOD;
+    _adlerB %= ADLER_MOD;
+    _adlerPending = 0;
+  }
+
+  if (_havePrev && b == _prev) {
+    if (_run == 258) flushRun();
+    _run++;
+    return;
+  }
+  flushRun();
+  literal(b);
+  _prev = b;
+  _havePrev = true;
+}
+
+// Повторы предыдущего байта: от трёх - ссылка на расстояние 1, иначе литералы
+void PngEncoder::flushRun() {
+  if (_run < 3) {
+    for (; _run > 0; _run--) literal(_prev);
+    return;
+  }
+  int i = 28;
+  while (LENGTH_BASE[i] > _run) i--;
+  code(litCodes[257 + i], LIT_LENGTHS[257 + i]);
+  if (LENGTH_EXTRA[i]) bits((uint32_t)(_run - LENGTH_BASE[i]), LENGTH_EXTRA[i]);
+  code(0, 1);   // расстояние 1
+  _run = 0;
+}
+
+void PngEncoder::literal(uint8_t b) {
+  code(litCodes[b], LIT_LENGTHS[b]);
+}
+
+void PngEncoder::bits(uint32_t value, int count) {
+  _bitBuf |= value << _bitCount;
+  _bitCount += count;
+  while (_bitCount >= 8) {
+    putByte((uint8_t)_bitBuf);
+    _bitBuf >>= 8;
+    _bitCount -= 8;
+  }
+}
+
+void PngEncoder::code(uint32_t c, int length) {
+  uint32_t reversed = 0;
+  for (int i = 0; i < length; i++, c >>= 1) reversed = (reversed << 1) | (c & 1);
+  bits(reversed, length);
+}
+
+bool PngEncoder::end() {
+  if (!_ok) return false;
+  flushRun();
+  code(litCodes[256], LIT_LENGTHS[256]);   // конец блока
+  if (_bitCount) putByte((uint8_t)_bitBuf);
+  _bitBuf = 0;
+  _bitCount = 0;
+
+  uint32_t adler = (_adlerB % ADLER_MOD) << 16 | (_adlerA % ADLER_MOD);
+  putByte(adler >> 24);
+  putByte(adler >> 16);
+  putByte(adler >> 8);
+  putByte(adler);
+  flushChunk();
+  chunk("IEND", nullptr, 0);
+  return _ok;
+}
+
+void PngEncoder::flushChunk() {
+  if (_len) chunk("IDAT", _chunk, _len);
+  _len = 0;
+}
+
+void PngEncoder::chunk(const char *type, const uint8_t *payload, size_t len) {
+  uint8_t head[8];
+  putBE32(head, (uint32_t)len);
+  memcpy(head + 4, type, 4);
+  uint32_t crc = crc32Update(0xFFFFFFFF, head + 4, 4);
+  if (len) crc = crc32Update(crc, payload, len);
+  uint8_t tail[4];
+  putBE32(tail, ~crc);
+  write(head, sizeof(head));
+  if (len) write(payload, len);
+  write(tail, sizeof(tail));
+}
+
+void PngEncoder::write(const uint8_t *p, size_t len) {
+  if (_ok && _writer(_arg, p, len) != len) _ok = false;
+  _bytes += len;
+}
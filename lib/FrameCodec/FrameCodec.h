@@ -0,0 +1,105 @@
+#ifndef FRAME_CODEC_H
+#define FRAME_CODEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Сжатие кадра без потерь за один проход по строкам сверху вниз: QOI и PNG.
+// Вход - строка RGB888 (channels = 3) или серая (channels = 1). Весь выход
+// идёт через небольшой буфер внутри кодера в writer, так что память не
+// зависит от размера кадра. Writer вернул меньше, чем просили - ошибка,
+// дальше кодер ничего не пишет. Без Arduino.
+//
+//   PngEncoder png(sendToClient, &client);
+//   png.begin(w, h, 3);
+//   for (int y = 0; y < h; y++) png.writeRow(rgb + y * w * 3);
+//   png.end();
+
+typedef size_t (*CodecWriter)(void *arg, const uint8_t *data, size_t len);
+
+// QOI (qoiformat.org): индекс из 64 цветов, разности, серии. Серый кадр
+// пишется как RGB (R = G = B) - в QOI нет одноканального режима
+class QoiEncoder {
+ public:
+  static const size_t BUF_SIZE = 512;
+
+  QoiEncoder(CodecWriter writer, void *arg) : _writer(writer), _arg(arg) {}
+
+  bool begin(int width, int height, int channels);
+  bool writeRow(const uint8_t *pixels);
+  bool end();
+
+  bool ok() const { return _ok; }
+  size_t bytes() const { return _bytes; }
+
+ private:
+  void put(uint8_t b) {
+    if (_len == BUF_SIZE) flush();
+    _buf[_len++] = b;
+  }
+  void pixel(uint8_t r, uint8_t g, uint8_t b);
+  void flushRun();
+  void flush();
+
+  CodecWriter _writer;
+  void *_arg;
+  bool _ok = false;
+  size_t _bytes = 0;
+  int _width = 0, _channels = 3;
+  uint8_t _index[64][3];
+  bool _valid[64];
+  uint8_t _prev[3];
+  int _run = 0;
+  uint8_t _buf[BUF_SIZE];
+  size_t _len = 0;
+};
+
+// PNG 8 бит, RGB или серый. Фильтр Sub (нужна только предыдущая точка
+// строки), deflate - один блок с постоянной таблицей Хаффмана под малые
+// разности, где повторы байта кодируются ссылкой на расстояние 1: после
+// Sub ровный фон - нули, и серии нулей сжимаются до пары кодов на 258 байт
+class PngEncoder {
+ public:
+  static const size_t CHUNK_SIZE = 1024;   // данные одного IDAT
+
+  PngEncoder(CodecWriter writer, void *arg) : _writer(writer), _arg(arg) {}
+
+  bool begin(int width, int height, int channels);
+  bool writeRow(const uint8_t *pixels);
+  bool end();
+
+  bool ok() const { return _ok; }
+  size_t bytes() const { return _bytes; }
+
+ private:
+  // Байт распакованного потока: Adler-32 и серия / литерал в deflate
+  void data(uint8_t b);
+  void flushRun();
+  void literal(uint8_t b);
+  void bits(uint32_t value, int count);
+  void code(uint32_t code, int length);   // код Хаффмана, старшим битом вперёд
+  void putByte(uint8_t b) {
+    if (_len == CHUNK_SIZE) flushChunk();
+    _chunk[_len++] = b;
+  }
+  void flushChunk();
+  void chunk(const char *type, const uint8_t *payload, size_t len);
+  void write(const uint8_t *p, size_t len);
+
+  CodecWriter _writer;
+  void *_arg;
+  bool _ok = false;
+  size_t _bytes = 0;
+  int _width = 0, _channels = 3;
+  uint32_t _adlerA = 1, _adlerB = 0;
+  int _adlerPending = 0;
+  bool _havePrev = false;
+  uint8_t _prev = 0;
+  int _run = 0;
+  uint32_t _bitBuf = 0;
+  int _bitCount = 0;
+  uint8_t _chunk[CHUNK_SIZE];
+  size_t _len = 0;
+};
+
+#endif
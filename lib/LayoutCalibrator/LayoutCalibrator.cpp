@@ -0,0 +1,339 @@
+#include "LayoutCalibrator.h"
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+const int MIN_CONTRAST = 30;   // разрыв между средними тёмного и светлого классов
+const int MIN_BLOB_AREA = 2;   // компоненты меньше - шум
+const int MAX_BLOBS = 128;
+const int MAX_RUNS = 64;
+
+struct Run { int start, end; };  // [start, end)
+
+struct Blob {
+  int x0, y0, x1, y1;   // [x0, x1) x [y0, y1)
+  int area;
+  int sumX, sumY;
+};
+
+// Порог Otsu по гистограмме 0..255; lowMean/highMean - средние классов
+int otsu(const uint32_t *hist, uint32_t total, int &lowMean, int &highMean) {
+  uint64_t sumAll = 0;
+  for (int i = 0; i < 256; i++) sumAll += (uint64_t)i * hist[i];
+  uint64_t sumLow = 0;
+  uint32_t nLow = 0;
+  double best = -1;
+  int thr = 0;
+  lowMean = highMean = 0;
+  for (int t = 0; t < 255; t++) {
+    nLow += hist[t];
+    sumLow += (uint64_t)t * hist[t];
+    uint32_t nHigh = total - nLow;
+    if (!nLow || !nHigh) continue;
+    double mLow = (double)sumLow / nLow;
+    double mHigh = (double)(sumAll - sumLow) / nHigh;
+    double between = (double)nLow * nHigh * (mHigh - mLow) * (mHigh - mLow);
+    if (between > best) {
+      best = between;
+      thr = t;
+      lowMean = (int)mLow;
+      highMean = (int)mHigh;
+    }
+  }
+  return thr;
+}
+
+// Непрерывные участки, где proj > 0; участки с разрывом не больше maxGap сливаются
+int findRuns(const int *proj, int n, int maxGap, Run *runs, int maxRuns) {
+  int count = 0;
+  int i = 0;
+  while (i < n) {
+    if (proj[i] <= 0) { i++; continue; }
+    int start = i;
+    while (i < n && proj[i] > 0) i++;
+    if (count > 0 && start - runs[count - 1].end <= maxGap) {
+      runs[count - 1].end = i;
+    } else if (count < maxRuns) {
+      runs[count++] = Run{start, i};
+    }
+  }
+  return count;
+}
+
+// Пик проекции на [from, to) и полоса вокруг него, где значение выше
+// середины между пиком и фоном участка (минимумом на нём)
+bool peakBand(const int *proj, int from, int to, Run &band) {
+  if (from >= to) return false;
+  int best = from, low = proj[from];
+  for (int i = from + 1; i < to; i++) {
+    if (proj[i] > proj[best]) best = i;
+    if (proj[i] < low) low = proj[i];
+  }
+  if (proj[best] <= low) return false;
+  int half = (proj[best] + low + 1) / 2;
+  int s = best, e = best + 1;
+  while (s > from && proj[s - 1] >= half) s--;
+  while (e < to && proj[e] >= half) e++;
+  band = Run{s, e};
+  return true;
+}
+
+// Прямоугольник сегмента; вдоль сегмента отступаем по пикселю с каждого
+// конца, чтобы выборка не задевала соседние сегменты, а толстую (размытую)
+// полосу сужаем до середины
+Rect segmentRect(int x0, int x1, int y0, int y1, bool horizontal) {
+  if (horizontal && x1 - x0 > 3) { x0++; x1--; }
+  if (!horizontal && y1 - y0 > 3) { y0++; y1--; }
+  if (horizontal && y1 - y0 >= 5) { y0++; y1--; }
+  if (!horizontal && x1 - x0 >= 5) { x0++; x1--; }
+  if (x1 <= x0) x1 = x0 + 1;
+  if (y1 <= y0) y1 = y0 + 1;
+  return Rect{x0, y0, x1 - x0, y1 - y0};
+}
+
+}  // namespace
+
+// Сегменты одной цифры по проекциям маски внутри её рамки
+static bool findSegments(const uint8_t *mask, int stride, const Rect &box, int *rowP, int *colP,
+                         Rect *seg) {
+  int x0 = box.x, x1 = box.x + box.w, y0 = box.y, y1 = box.y + box.h;
+  int h = box.h;
+  if (box.w < 3 || h < 5) return false;
+
+  // Перекладины ищем по средней трети ширины: там нет столбцов, даже
+  // с наклонным шрифтом и размытием
+  int cx0 = x0 + box.w / 3, cx1 = x1 - box.w / 3;
+  for (int y = y0; y < y1; y++) {
+    int c = 0;
+    for (int x = cx0; x < cx1; x++) c += mask[y * stride + x];
+    rowP[y] = c;
+  }
+  // Три перекладины: по одной в каждой трети высоты
+  Run top, mid, bot;
+  if (!peakBand(rowP, y0, y0 + h / 3, top) ||
+      !peakBand(rowP, y0 + h / 3, y0 + 2 * h / 3, mid) ||
+      !peakBand(rowP, y0 + 2 * h / 3, y1, bot)) return false;
+  if (top.end >= mid.start || mid.end >= bot.start) return false;
+
+  // Столбцы - отдельно для верхней и нижней половины (наклонный шрифт)
+  Run ul, ur, ll, lr;
+  int xm = (x0 + x1) / 2;
+  for (int half = 0; half < 2; half++) {
+    int ys = half ? mid.end : top.end;
+    int ye = half ? bot.start : mid.start;
+    for (int x = x0; x < x1; x++) {
+      int c = 0;
+      for (int y = ys; y < ye; y++) c += mask[y * stride + x];
+      colP[x] = c;
+    }
+    Run &l = half ? ll : ul;
+    Run &r = half ? lr : ur;
+    if (!peakBand(colP, x0, xm, l) || !peakBand(colP, xm, x1, r)) return false;
+    if (l.end >= r.start) return false;
+  }
+
+  seg[0] = segmentRect(ul.end, ur.start, top.start, top.end, true);
+  seg[1] = segmentRect(ur.start, ur.end, top.end, mid.start, false);
+  seg[2] = segmentRect(lr.start, lr.end, mid.end, bot.start, false);
+  seg[3] = segmentRect(ll.end, lr.start, bot.start, bot.end, true);
+  seg[4] = segmentRect(ll.start, ll.end, mid.end, bot.start, false);
+  seg[5] = segmentRect(ul.start, ul.end, top.end, mid.start, false);
+  seg[6] = segmentRect((ul.end + ll.end) / 2, (ur.start + lr.start) / 2, mid.start, mid.end, true);
+  return true;
+}
+
+CalibrationStatus calibrateLayout(const uint8_t *buf, int frameW, int frameH, LumaFormat fmt,
+                                  const Rect &roi, int digits, int leds, LayoutProposal &out) {
+  out.digitCount = out.ledCount = 0;
+  if (digits < 1 || digits > CAL_MAX_DIGITS || leds < 0 || leds > CAL_MAX_LEDS) return CAL_BAD_PROFILE;
+  Rect r = rectIntersect(roi, Rect{0, 0, frameW, frameH});
+  if (r.w != roi.w || r.h != roi.h || r.w < 4 || r.h < 4) return CAL_BAD_ROI;
+  const int w = r.w, h = r.h;
+
+  // ---- Порог ----
+  uint32_t hist[256] = {0};
+  for (int y = 0; y < h; y++) {
+    size_t base = (size_t)((frameH - 1) - (r.y + y)) * frameW + r.x;
+    for (int x = 0; x < w; x++) hist[lumaAt(buf, base + x, fmt)]++;
+  }
+  int lowMean, highMean;
+  int thr = otsu(hist, (uint32_t)w * h, lowMean, highMean);
+  if (highMean - lowMean < MIN_CONTRAST) return CAL_LOW_CONTRAST;
+  out.threshold = thr;
+
+  uint8_t *mask = (uint8_t*)malloc((size_t)w * h);
+  uint32_t *queue = (uint32_t*)malloc((size_t)w * h * sizeof(uint32_t));
+  int *proj = (int*)malloc((size_t)(w > h ? w : h) * 2 * sizeof(int));
+  Blob *blobs = (Blob*)malloc(MAX_BLOBS * sizeof(Blob));
+  if (!mask || !queue || !proj || !blobs) {
+    free(mask); free(queue); free(proj); free(blobs);
+    return CAL_NO_MEM;
+  }
+  int *rowP = proj;
+  int *colP = proj + (w > h ? w : h);
+
+  for (int y = 0; y < h; y++) {
+    size_t base = (size_t)((frameH - 1) - (r.y + y)) * frameW + r.x;
+    for (int x = 0; x < w; x++) mask[y * w + x] = lumaAt(buf, base + x, fmt) > thr ? 1 : 0;
+  }
+
+  // ---- Связные компоненты (8-связность), шум стираем из маски ----
+  // Посещённые пиксели временно помечаются 2
+  int blobCount = 0;
+  for (int i = 0; i < w * h; i++) {
+    if (mask[i] != 1) continue;
+    int n = 0;
+    queue[n++] = i;
+    mask[i] = 2;
+    Blob b = { w, h, 0, 0, 0, 0, 0 };
+    for (int q = 0; q < n; q++) {
+      int p = queue[q];
+      int px = p % w, py = p / w;
+      if (px < b.x0) b.x0 = px;
+      if (py < b.y0) b.y0 = py;
+      if (px + 1 > b.x1) b.x1 = px + 1;
+      if (py + 1 > b.y1) b.y1 = py + 1;
+      b.sumX += px;
+      b.sumY += py;
+      for (int dy = -1; dy <= 1; dy++) {
+        int ny = py + dy;
+        if (ny < 0 || ny >= h) continue;
+        for (int dx = -1; dx <= 1; dx++) {
+          int nx = px + dx;
+          if (nx < 0 || nx >= w) continue;
+          int np = ny * w + nx;
+          if (mask[np] == 1) { mask[np] = 2; queue[n++] = np; }
+        }
+      }
+    }
+    b.area = n;
+    if (n < MIN_BLOB_AREA) {
+      for (int q = 0; q < n; q++) mask[queue[q]] = 0;
+    } else if (blobCount < MAX_BLOBS) {
+      blobs[blobCount++] = b;
+    }
+  }
+  for (int i = 0; i < w * h; i++) if (mask[i]) mask[i] = 1;
+
+  CalibrationStatus status = CAL_OK;
+  Run runs[MAX_RUNS];
+
+  // ---- Полоса цифр: самая высокая полоса строк с засветкой ----
+  for (int y = 0; y < h; y++) {
+    int c = 0;
+    for (int x = 0; x < w; x++) c += mask[y * w + x];
+    rowP[y] = c;
+  }
+  int bands = findRuns(rowP, h, 1, runs, MAX_RUNS);
+  Run band = {0, 0};
+  for (int i = 0; i < bands; i++) {
+    if (runs[i].end - runs[i].start > band.end - band.start) band = runs[i];
+  }
+  if (band.end - band.start < 5) status = CAL_DIGITS_NOT_FOUND;
+
+  // ---- Цифры: участки столбцов внутри полосы ----
+  int digitRuns = 0;
+  if (status == CAL_OK) {
+    for (int x = 0; x < w; x++) {
+      int c = 0;
+      for (int y = band.start; y < band.end; y++) c += mask[y * w + x];
+      colP[x] = c;
+    }
+    digitRuns = findRuns(colP, w, 1, runs, MAX_RUNS);
+    // Лишние участки: сначала отбрасываем узкие (точки, двоеточия),
+    // потом сливаем соседей с наименьшим промежутком
+    for (int i = 0; i < digitRuns && digitRuns > digits; ) {
+      if (runs[i].end - runs[i].start < 3) {
+        memmove(&runs[i], &runs[i + 1], (digitRuns - i - 1) * sizeof(Run));
+        digitRuns--;
+      } else {
+        i++;
+      }
+    }
+    while (digitRuns > digits) {
+      int gi = 0;
+      for (int i = 1; i < digitRuns - 1; i++) {
+        if (runs[i + 1].start - runs[i].end < runs[gi + 1].start - runs[gi].end) gi = i;
+      }
+      runs[gi].end = runs[gi + 1].end;
+      memmove(&runs[gi + 1], &runs[gi + 2], (digitRuns - gi - 2) * sizeof(Run));
+      digitRuns--;
+    }
+    if (digitRuns != digits) status = CAL_DIGITS_NOT_FOUND;
+  }
+
+  // ---- Сегменты каждой цифры ----
+  for (int d = 0; status == CAL_OK && d < digits; d++) {
+    // Высота цифры - строки полосы, где в её столбцах есть засветка
+    int y0 = band.end, y1 = band.start;
+    for (int y = band.start; y < band.end; y++) {
+      for (int x = runs[d].start; x < runs[d].end; x++) {
+        if (mask[y * w + x]) { if (y < y0) y0 = y; y1 = y + 1; break; }
+      }
+    }
+    Rect box = { runs[d].start, y0, runs[d].end - runs[d].start, y1 - y0 };
+    out.digitBoxes[d] = box;
+    if (!findSegments(mask, w, box, rowP, colP, out.segments[d])) status = CAL_SEGMENTS_NOT_FOUND;
+  }
+
+  // ---- Светодиоды: компоненты вне полосы цифр, самые крупные ----
+  if (status == CAL_OK && leds > 0) {
+    int found = 0;
+    Blob pick[CAL_MAX_LEDS];
+    for (int i = 0; i < blobCount; i++) {
+      const Blob &b = blobs[i];
+      if (b.y1 > band.start && b.y0 < band.end) continue;
+      // Вставка по убыванию площади, храним только leds лучших
+      int pos = found < leds ? found : leds;
+      while (pos > 0 && pick[pos - 1].area < b.area) {
+        if (pos < leds) pick[pos] = pick[pos - 1];
+        pos--;
+      }
+      if (pos < leds) {
+        pick[pos] = b;
+        if (found < leds) found++;
+      }
+    }
+    if (found < leds) {
+      status = CAL_LEDS_NOT_FOUND;
+    } else {
+      // Слева направо, как в topLEDs
+      for (int i = 1; i < leds; i++) {
+        Blob b = pick[i];
+        int j = i;
+        while (j > 0 && pick[j - 1].x0 > b.x0) { pick[j] = pick[j - 1]; j--; }
+        pick[j] = b;
+      }
+      for (int i = 0; i < leds; i++) {
+        const Blob &b = pick[i];
+        int cw = (b.x1 - b.x0) < 3 ? (b.x1 - b.x0) : 3;
+        int ch = (b.y1 - b.y0) < 3 ? (b.y1 - b.y0) : 3;
+        int cx = b.sumX / b.area, cy = b.sumY / b.area;
+        out.leds[i] = Rect{ cx - cw / 2, cy - ch / 2, cw, ch };
+      }
+      out.ledCount = leds;
+    }
+  }
+  if (status == CAL_OK) out.digitCount = digits;
+
+  free(mask);
+  free(queue);
+  free(proj);
+  free(blobs);
+  return status;
+}
+
+const char *calibrationStatusName(CalibrationStatus s) {
+  switch (s) {
+    case CAL_OK:                 return "ok";
+    case CAL_NO_MEM:             return "out of memory";
+    case CAL_BAD_ROI:            return "ROI outside the frame";
+    case CAL_BAD_PROFILE:        return "bad digit or LED count";
+    case CAL_LOW_CONTRAST:       return "low contrast";
+    case CAL_DIGITS_NOT_FOUND:   return "digits not found";
+    case CAL_SEGMENTS_NOT_FOUND: return "segments not found";
+    case CAL_LEDS_NOT_FOUND:     return "LEDs not found";
+  }
+  return "unknown";
+}
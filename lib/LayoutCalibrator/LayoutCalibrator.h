@@ -0,0 +1,43 @@
+#ifndef LAYOUT_CALIBRATOR_H
+#define LAYOUT_CALIBRATOR_H
+
+#include <stdint.h>
+#include "LumaSampler.h"
+
+// Поиск разметки по калибровочному кадру: на индикаторе "88" (все
+// сегменты), все светодиоды горят. Кадр внутри ROI бинаризуется по порогу
+// Otsu, связные компоненты отсеивают шум и дают светодиоды, а проекции
+// строк и столбцов - положение цифр и их сегментов. Результат - в
+// координатах ROI, как segPos/topLEDs. Без Arduino, запускается и на ПК.
+
+const int CAL_MAX_DIGITS = 8;
+const int CAL_MAX_LEDS = 16;
+const int CAL_SEGMENTS = 7;
+
+enum CalibrationStatus : uint8_t {
+  CAL_OK = 0,
+  CAL_NO_MEM,
+  CAL_BAD_ROI,          // ROI пуст или выходит за кадр
+  CAL_BAD_PROFILE,      // цифр меньше одной или цифр/светодиодов больше предела
+  CAL_LOW_CONTRAST,     // не на чем строить порог
+  CAL_DIGITS_NOT_FOUND, // не нашлось нужного числа цифр
+  CAL_SEGMENTS_NOT_FOUND, // в цифре не видно трёх перекладин и двух столбцов
+  CAL_LEDS_NOT_FOUND    // светодиодов меньше, чем нужно
+};
+
+struct LayoutProposal {
+  Rect segments[CAL_MAX_DIGITS][CAL_SEGMENTS];  // бит s маски - сегмент s
+  Rect leds[CAL_MAX_LEDS];
+  Rect digitBoxes[CAL_MAX_DIGITS];
+  int digitCount = 0;
+  int ledCount = 0;
+  int threshold = 0;
+};
+
+// buf - кадр (строки в буфере снизу вверх), roi - в координатах дисплея
+CalibrationStatus calibrateLayout(const uint8_t *buf, int frameW, int frameH, LumaFormat fmt,
+                                  const Rect &roi, int digits, int leds, LayoutProposal &out);
+
+const char *calibrationStatusName(CalibrationStatus s);
+
+#endif
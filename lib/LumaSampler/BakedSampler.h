@@ -0,0 +1,141 @@
+#ifndef BAKED_SAMPLER_H
+#define BAKED_SAMPLER_H
+
+#include "LumaSampler.h"
+
+// Выборка для разметки, вшитой в прошивку: размер кадра, формат, ROI и все
+// прямоугольники - параметры шаблона. Смещения каждой строки считаются при
+// компиляции, строки и пиксели разворачиваются полностью, деление на площадь
+// - на константу. Выход за кадр проверяется static_assert, на кадре ни
+// геометрии, ни проверок границ. Развёртка - рекурсией шаблонов, так что
+// хватает C++11.
+//
+//   typedef BakedSampler<160, 120, LUMA_RGB565, 10, 48,
+//                        BakedRect<57, 37, 6, 3>, ...> Sampler;
+//   Sampler::sample(fb, means);   // means[0..Sampler::COUNT-1]
+
+// Прямоугольник в координатах ROI, как в разметке
+template <int X, int Y, int W, int H>
+struct BakedRect {
+  static const int x = X, y = Y, w = W, h = H;
+};
+
+namespace baked {
+
+template <LumaFormat F> struct Pixel;
+template <> struct Pixel<LUMA_RGB565> {
+  static const int BPP = 2;
+  static inline uint32_t luma(const uint8_t *p) { return rgb565ToGray(*(const uint16_t*)p); }
+};
+template <> struct Pixel<LUMA_GRAY8> {
+  static const int BPP = 1;
+  static inline uint32_t luma(const uint8_t *p) { return *p; }
+};
+template <> struct Pixel<LUMA_YUV422> {
+  static const int BPP = 2;
+  static inline uint32_t luma(const uint8_t *p) { return *p; }
+};
+
+// Как читать пиксели с байта OFF: смещение известно при компиляции, а буфер
+// кадра выровнен на 4, так что выравнивание под 32-битное чтение - тоже
+enum { ONE = 0, RGB565_PAIR, GRAY8_QUAD };
+template <LumaFormat F, uint32_t OFF, int N>
+struct Step {
+  static const int value =
+      (F == LUMA_RGB565 && OFF % 4 == 0 && N >= 2) ? RGB565_PAIR :
+      (F == LUMA_GRAY8 && OFF % 4 == 0 && N >= 4) ? GRAY8_QUAD : ONE;
+};
+
+// N подряд идущих пикселей, начиная с байта OFF
+template <LumaFormat F, uint32_t OFF, int N, int STEP = Step<F, OFF, N>::value>
+struct Run {
+  __attribute__((always_inline)) static inline uint32_t sum(const uint8_t *buf) {
+    return Pixel<F>::luma(buf + OFF) + Run<F, OFF + Pixel<F>::BPP, N - 1>::sum(buf);
+  }
+};
+template <LumaFormat F, uint32_t OFF>
+struct Run<F, OFF, 0, ONE> {
+  static inline uint32_t sum(const uint8_t *) { return 0; }
+};
+template <LumaFormat F, uint32_t OFF, int N>
+struct Run<F, OFF, N, RGB565_PAIR> {
+  __attribute__((always_inline)) static inline uint32_t sum(const uint8_t *buf) {
+    uint32_t v = *(const uint32_t*)(buf + OFF);
+    return rgb565ToGray(v & 0xFFFF) + rgb565ToGray(v >> 16) + Run<F, OFF + 4, N - 2>::sum(buf);
+  }
+};
+template <LumaFormat F, uint32_t OFF, int N>
+struct Run<F, OFF, N, GRAY8_QUAD> {
+  __attribute__((always_inline)) static inline uint32_t sum(const uint8_t *buf) {
+    uint32_t v = *(const uint32_t*)(buf + OFF);
+    uint32_t t = (v & 0x00FF00FF) + ((v >> 8) & 0x00FF00FF);
+    return (t & 0xFFFF) + (t >> 16) + Run<F, OFF + 4, N - 4>::sum(buf);
+  }
+};
+
+// ROWS строк прямоугольника, начиная со строки буфера ROW и вниз по буферу
+// (вверх по дисплею строки буфера идут в обратном порядке)
+template <LumaFormat F, int FW, int ROW, int X, int W, int ROWS>
+struct Rows {
+  __attribute__((always_inline)) static inline uint32_t sum(const uint8_t *buf) {
+    return Run<F, ((uint32_t)ROW * FW + X) * Pixel<F>::BPP, W>::sum(buf) +
+           Rows<F, FW, ROW - 1, X, W, ROWS - 1>::sum(buf);
+  }
+};
+template <LumaFormat F, int FW, int ROW, int X, int W>
+struct Rows<F, FW, ROW, X, W, 0> {
+  static inline uint32_t sum(const uint8_t *) { return 0; }
+};
+
+}  // namespace baked
+
+template <int FW, int FH, LumaFormat F, int RX, int RY, class... Rects>
+struct BakedSampler;
+
+template <int FW, int FH, LumaFormat F, int RX, int RY>
+struct BakedSampler<FW, FH, F, RX, RY> {
+  static const int COUNT = 0;
+  static inline void sample(const uint8_t *, int *) {}
+  static inline void rects(Rect *) {}
+  static inline bool sameRects(const Rect *) { return true; }
+};
+
+template <int FW, int FH, LumaFormat F, int RX, int RY, class R, class... Rest>
+struct BakedSampler<FW, FH, F, RX, RY, R, Rest...> {
+  static_assert(R::w > 0 && R::h > 0, "baked rect is empty");
+  static_assert(RX + R::x >= 0 && RY + R::y >= 0 &&
+                RX + R::x + R::w <= FW && RY + R::y + R::h <= FH, "baked rect is outside the frame");
+
+  typedef BakedSampler<FW, FH, F, RX, RY, Rest...> Next;
+  static const int COUNT = 1 + Next::COUNT;
+  static const int FRAME_W = FW, FRAME_H = FH, ROI_X = RX, ROI_Y = RY;
+  static const LumaFormat FORMAT = F;
+
+  // Средние яркости всех прямоугольников: means[0..COUNT-1]
+  static inline void sample(const uint8_t *buf, int *means) {
+    uint32_t sum = baked::Rows<F, FW, FH - 1 - (RY + R::y), RX + R::x, R::w, R::h>::sum(buf);
+    means[0] = (int)(sum / (uint32_t)(R::w * R::h));
+    Next::sample(buf, means + 1);
+  }
+
+  // Разметка в координатах ROI - для runtime-пути и отрисовки
+  static inline void rects(Rect *out) {
+    out[0] = Rect{ R::x, R::y, R::w, R::h };
+    Next::rects(out + 1);
+  }
+
+  static inline bool sameRects(const Rect *r) {
+    return r[0].x == R::x && r[0].y == R::y && r[0].w == R::w && r[0].h == R::h &&
+           Next::sameRects(r + 1);
+  }
+
+  // Текущая геометрия всё ещё та, что вшита: тогда выборка совпадает с
+  // планом выборки бит в бит
+  static bool matches(int frameW, int frameH, LumaFormat fmt, int roiX, int roiY,
+                      const Rect *layout, int count) {
+    return frameW == FW && frameH == FH && fmt == F && roiX == RX && roiY == RY &&
+           count == COUNT && sameRects(layout);
+  }
+};
+
+#endif
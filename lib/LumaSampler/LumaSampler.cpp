@@ -0,0 +1,544 @@
+#include "LumaSampler.h"
+#include <stdlib.h>
+
+uint32_t LUMA_R[32];
+uint32_t LUMA_G[64];
+uint32_t LUMA_B[32];
+
+void initLumaTables() {
+  for (int i = 0; i < 32; i++) {
+    LUMA_R[i] = (uint32_t)((i*255/31)*30) * 5243;
+    LUMA_B[i] = (uint32_t)((i*255/31)*11) * 5243;
+  }
+  for (int i = 0; i < 64; i++) {
+    LUMA_G[i] = (uint32_t)((i*255/63)*59) * 5243;
+  }
+}
+
+uint32_t lumaSumRGB565(const uint8_t *p, int len) {
+  uint32_t acc = 0;
+  // Выравниваем на 4 байта, чтобы дальше читать по два пикселя за раз
+  if (len > 0 && ((uintptr_t)p & 2)) {
+    acc += rgb565ToGray(*(const uint16_t*)p);
+    p += 2;
+    len--;
+  }
+  const uint32_t *w = (const uint32_t*)p;
+  for (; len >= 2; len -= 2) {
+    uint32_t v = *w++;
+    acc += rgb565ToGray(v & 0xFFFF) + rgb565ToGray(v >> 16);
+  }
+  if (len) acc += rgb565ToGray(*(const uint16_t*)w);
+  return acc;
+}
+
+uint32_t lumaSumGray8(const uint8_t *p, int len) {
+  uint32_t acc = 0;
+  for (; len > 0 && ((uintptr_t)p & 3); len--) acc += *p++;
+  const uint32_t *w = (const uint32_t*)p;
+  for (; len >= 4; len -= 4) {
+    // Складываем четыре байта попарно в 16-битных полях слова
+    uint32_t v = *w++;
+    uint32_t t = (v & 0x00FF00FF) + ((v >> 8) & 0x00FF00FF);
+    acc += (t & 0xFFFF) + (t >> 16);
+  }
+  p = (const uint8_t*)w;
+  for (; len > 0; len--) acc += *p++;
+  return acc;
+}
+
+uint32_t lumaSumYUV422(const uint8_t *p, int len) {
+  uint32_t acc = 0;
+  if (len > 0 && ((uintptr_t)p & 2)) {
+    acc += p[0];
+    p += 2;
+    len--;
+  }
+  // Y0 U Y1 V - два значения яркости на слово
+  const uint32_t *w = (const uint32_t*)p;
+  for (; len >= 2; len -= 2) {
+    uint32_t v = *w++;
+    acc += (v & 0xFF) + ((v >> 16) & 0xFF);
+  }
+  if (len) acc += *(const uint8_t*)w;
+  return acc;
+}
+
+int lumaSelfTest() {
+  int bad = 0;
+  for (uint32_t pix = 0; pix < 65536; pix++) {
+    if (rgb565ToGray(pix) != rgb565ToGrayRef(pix)) bad++;
+  }
+  return bad;
+}
+
+Rect rectIntersect(const Rect &a, const Rect &b) {
+  int x0 = a.x > b.x ? a.x : b.x;
+  int y0 = a.y > b.y ? a.y : b.y;
+  int x1 = (a.x + a.w) < (b.x + b.w) ? (a.x + a.w) : (b.x + b.w);
+  int y1 = (a.y + a.h) < (b.y + b.h) ? (a.y + a.h) : (b.y + b.h);
+  if (x1 <= x0 || y1 <= y0) return Rect{x0, y0, 0, 0};
+  return Rect{x0, y0, x1 - x0, y1 - y0};
+}
+
+Rect rectUnion(const Rect &a, const Rect &b) {
+  if (a.w <= 0 || a.h <= 0) return b;
+  if (b.w <= 0 || b.h <= 0) return a;
+  int x0 = a.x < b.x ? a.x : b.x;
+  int y0 = a.y < b.y ? a.y : b.y;
+  int x1 = (a.x + a.w) > (b.x + b.w) ? (a.x + a.w) : (b.x + b.w);
+  int y1 = (a.y + a.h) > (b.y + b.h) ? (a.y + a.h) : (b.y + b.h);
+  return Rect{x0, y0, x1 - x0, y1 - y0};
+}
+
+// Деление с округлением вниз и для отрицательных координат
+static int floorDiv(int a, int b) {
+  return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+bool Homography::apply(float x, float y, float &ox, float &oy) const {
+  float w = m[6] * x + m[7] * y + m[8];
+  if (w <= 1e-6f) return false;
+  ox = (m[0] * x + m[1] * y + m[2]) / w;
+  oy = (m[3] * x + m[4] * y + m[5]) / w;
+  return true;
+}
+
+Homography Homography::translated(float dx, float dy) const {
+  Homography r = *this;
+  for (int i = 0; i < 3; i++) {
+    r.m[i] += dx * m[6 + i];
+    r.m[3 + i] += dy * m[6 + i];
+  }
+  return r;
+}
+
+Homography Homography::scaled(float sx, float sy) const {
+  Homography r = *this;
+  for (int i = 0; i < 3; i++) {
+    r.m[i] *= sx;
+    r.m[3 + i] *= sy;
+  }
+  return r;
+}
+
+bool Homography::fromPoints(const float *src, const float *dst) {
+  // Восемь уравнений на h0..h7:
+  // u = (h0 x + h1 y + h2) / (h6 x + h7 y + 1), v - аналогично с h3..h5
+  double a[8][9];
+  for (int i = 0; i < 4; i++) {
+    double x = src[2*i], y = src[2*i + 1], u = dst[2*i], v = dst[2*i + 1];
+    double r0[9] = { x, y, 1, 0, 0, 0, -u * x, -u * y, u };
+    double r1[9] = { 0, 0, 0, x, y, 1, -v * x, -v * y, v };
+    for (int k = 0; k < 9; k++) { a[2*i][k] = r0[k]; a[2*i + 1][k] = r1[k]; }
+  }
+  // Гаусс с выбором главного элемента
+  for (int c = 0; c < 8; c++) {
+    int piv = c;
+    for (int r = c + 1; r < 8; r++) {
+      double pr = a[r][c] < 0 ? -a[r][c] : a[r][c];
+      double pp = a[piv][c] < 0 ? -a[piv][c] : a[piv][c];
+      if (pr > pp) piv = r;
+    }
+    double pv = a[piv][c] < 0 ? -a[piv][c] : a[piv][c];
+    if (pv < 1e-9) return false;
+    if (piv != c) {
+      for (int k = 0; k < 9; k++) { double t = a[c][k]; a[c][k] = a[piv][k]; a[piv][k] = t; }
+    }
+    for (int r = 0; r < 8; r++) {
+      if (r == c) continue;
+      double f = a[r][c] / a[c][c];
+      for (int k = c; k < 9; k++) a[r][k] -= f * a[c][k];
+    }
+  }
+  for (int i = 0; i < 8; i++) m[i] = (float)(a[i][8] / a[i][i]);
+  m[8] = 1;
+  return true;
+}
+
+Rect FrameMapping::map(const Rect &r) const {
+  if (!active()) return r;
+  int x0 = floorDiv((r.x - window.x) * outW, window.w);
+  int y0 = floorDiv((r.y - window.y) * outH, window.h);
+  int x1 = floorDiv((r.x + r.w - window.x) * outW, window.w);
+  int y1 = floorDiv((r.y + r.h - window.y) * outH, window.h);
+  // Не даём непустому прямоугольнику схлопнуться при уменьшении
+  if (r.w > 0 && x1 <= x0) x1 = x0 + 1;
+  if (r.h > 0 && y1 <= y0) y1 = y0 + 1;
+  return Rect{x0, y0, x1 - x0, y1 - y0};
+}
+
+IntegralImage::~IntegralImage() {
+  free(_sum);
+}
+
+// Префиксные суммы одной строки; формат - параметр шаблона, чтобы
+// выбор формата не попадал во внутренний цикл
+template <LumaFormat F>
+static void integrateRow(const uint8_t *row, int w, const uint32_t *above, uint32_t *cur) {
+  uint32_t rowSum = 0;
+  cur[0] = 0;
+  for (int x = 0; x < w; x++) {
+    rowSum += lumaAt(row, x, F);
+    cur[x + 1] = above[x + 1] + rowSum;
+  }
+}
+
+bool IntegralImage::build(const uint8_t *buf, int frameW, int frameH, const Rect &area,
+                          LumaFormat fmt) {
+  _area = rectIntersect(area, Rect{0, 0, frameW, frameH});
+  _stride = _area.w + 1;
+  // Пустая область - не ошибка: mean() просто вернёт 0
+  if (_area.w <= 0 || _area.h <= 0) return true;
+
+  // Таблица на (w+1)*(h+1) с нулевыми первой строкой и столбцом.
+  // Память выделяется один раз и переиспользуется, пока область не выросла.
+  size_t need = (size_t)_stride * (_area.h + 1);
+  if (need > _capacity) {
+    uint32_t *p = (uint32_t*)realloc(_sum, need * sizeof(uint32_t));
+    if (!p) { _area.w = _area.h = 0; return false; }
+    _sum = p;
+    _capacity = need;
+  }
+
+  for (int i = 0; i < _stride; i++) _sum[i] = 0;
+
+  for (int y = 0; y < _area.h; y++) {
+    // В буфере строки идут снизу вверх
+    int row = (frameH - 1) - (_area.y + y);
+    const uint8_t *src = buf + ((size_t)row * frameW + _area.x) * lumaBytesPerPixel(fmt);
+    const uint32_t *above = _sum + (size_t)y * _stride;
+    uint32_t *cur = _sum + (size_t)(y + 1) * _stride;
+    switch (fmt) {
+      case LUMA_GRAY8:  integrateRow<LUMA_GRAY8>(src, _area.w, above, cur); break;
+      case LUMA_YUV422: integrateRow<LUMA_YUV422>(src, _area.w, above, cur); break;
+      default:          integrateRow<LUMA_RGB565>(src, _area.w, above, cur); break;
+    }
+  }
+  return true;
+}
+
+int IntegralImage::mean(const Rect &r) const {
+  Rect c = rectIntersect(r, _area);
+  if (c.w <= 0 || c.h <= 0) return 0;
+  int x0 = c.x - _area.x, y0 = c.y - _area.y;
+  int x1 = x0 + c.w, y1 = y0 + c.h;
+  uint32_t s = _sum[(size_t)y1 * _stride + x1] - _sum[(size_t)y0 * _stride + x1]
+             - _sum[(size_t)y1 * _stride + x0] + _sum[(size_t)y0 * _stride + x0];
+  return (int)(s / (uint32_t)(c.w * c.h));
+}
+
+SamplingPlan::~SamplingPlan() {
+  free(_points);
+  free(_spans);
+  free(_rects);
+  free(_pixels);
+  free(_sums);
+}
+
+bool SamplingPlan::reserveOwners(int count) {
+  if (count <= _ownerCapacity) return true;
+  Rect *r = (Rect*)realloc(_rects, count * sizeof(Rect));
+  if (r) _rects = r;
+  uint32_t *px = (uint32_t*)realloc(_pixels, count * sizeof(uint32_t));
+  if (px) _pixels = px;
+  uint32_t *sm = (uint32_t*)realloc(_sums, count * sizeof(uint32_t));
+  if (sm) _sums = sm;
+  if (!r || !px || !sm) return false;
+  _ownerCapacity = count;
+  return true;
+}
+
+bool SamplingPlan::compile(const Rect *rects, int count, int frameW, int frameH,
+                           LumaFormat fmt) {
+  _frameW = frameW;
+  _frameH = frameH;
+  _format = fmt;
+  _count = 0;
+  _spanCount = 0;
+  _pixelCount = 0;
+  _warped = false;
+
+  if (!reserveOwners(count)) return false;
+
+  // Обрезаем по кадру и считаем, сколько понадобится отрезков
+  const Rect frame = { 0, 0, frameW, frameH };
+  int spansNeeded = 0;
+  _area = Rect{0, 0, 0, 0};
+  for (int i = 0; i < count; i++) {
+    Rect c = rectIntersect(rects[i], frame);
+    if (c.w <= 0 || c.h <= 0) c.w = c.h = 0;
+    _rects[i] = c;
+    _pixels[i] = (uint32_t)c.w * c.h;
+    _pixelCount += _pixels[i];
+    spansNeeded += c.h;
+    _area = rectUnion(_area, c);
+  }
+  _count = count;
+
+  // Если прямоугольники в сумме больше охватывающей их области,
+  // дешевле один раз построить интегральное изображение
+  _useIntegral = _pixelCount > _area.w * _area.h;
+  if (_useIntegral) return true;
+
+  if (spansNeeded > _spanCapacity) {
+    SampleSpan *p = (SampleSpan*)realloc(_spans, spansNeeded * sizeof(SampleSpan));
+    if (!p) { _count = 0; return false; }
+    _spans = p;
+    _spanCapacity = spansNeeded;
+  }
+
+  // Отрезки идут в порядке адресов буфера, чтобы чтение шло подряд
+  for (int row = 0; row < frameH; row++) {
+    int y = (frameH - 1) - row;
+    for (int i = 0; i < count; i++) {
+      const Rect &c = _rects[i];
+      if (c.w == 0 || y < c.y || y >= c.y + c.h) continue;
+      SampleSpan &sp = _spans[_spanCount++];
+      sp.offset = ((uint32_t)row * frameW + c.x) * lumaBytesPerPixel(fmt);
+      sp.len = (uint16_t)c.w;
+      sp.owner = (uint16_t)i;
+    }
+  }
+  return true;
+}
+
+bool SamplingPlan::compileWarped(const Rect *rects, int count, const Homography &h,
+                                 int frameW, int frameH, LumaFormat fmt) {
+  _frameW = frameW;
+  _frameH = frameH;
+  _format = fmt;
+  _count = 0;
+  _spanCount = 0;
+  _pixelCount = 0;
+  _useIntegral = false;
+  _warped = true;
+
+  if (!reserveOwners(count)) return false;
+  int need = 0;
+  for (int i = 0; i < count; i++) {
+    if (rects[i].w > 0 && rects[i].h > 0) need += rects[i].w * rects[i].h;
+  }
+  if (need > _pointCapacity) {
+    uint32_t *p = (uint32_t*)realloc(_points, need * sizeof(uint32_t));
+    if (!p) return false;
+    _points = p;
+    _pointCapacity = need;
+  }
+
+  // Центр каждого пикселя разметки - в пиксель кадра
+  int n = 0;
+  for (int i = 0; i < count; i++) {
+    const Rect &r = rects[i];
+    int start = n;
+    for (int y = r.y; y < r.y + r.h; y++) {
+      for (int x = r.x; x < r.x + r.w; x++) {
+        float fx, fy;
+        if (!h.apply(x + 0.5f, y + 0.5f, fx, fy)) continue;
+        if (fx < 0 || fy < 0 || fx >= frameW || fy >= frameH) continue;
+        int row = (frameH - 1) - (int)fy;
+        _points[n++] = (uint32_t)row * frameW + (int)fx;
+      }
+    }
+    _pixels[i] = n - start;
+  }
+  _pixelCount = n;
+  _count = count;
+  return true;
+}
+
+// Сумма яркостей по списку номеров пикселей; формат - параметр шаблона
+template <LumaFormat F>
+static uint32_t sumPoints(const uint8_t *buf, const uint32_t *p, const uint32_t *end) {
+  uint32_t acc = 0;
+  for (; p < end; p++) acc += lumaAt(buf, *p, F);
+  return acc;
+}
+
+bool SamplingPlan::sample(const uint8_t *buf, int *means) {
+  if (_warped) {
+    const uint32_t *p = _points;
+    for (int i = 0; i < _count; i++) {
+      const uint32_t *end = p + _pixels[i];
+      uint32_t sum;
+      switch (_format) {
+        case LUMA_GRAY8:  sum = sumPoints<LUMA_GRAY8>(buf, p, end); break;
+        case LUMA_YUV422: sum = sumPoints<LUMA_YUV422>(buf, p, end); break;
+        default:          sum = sumPoints<LUMA_RGB565>(buf, p, end); break;
+      }
+      means[i] = _pixels[i] ? (int)(sum / _pixels[i]) : 0;
+      p = end;
+    }
+    return true;
+  }
+
+  if (_useIntegral) {
+    if (!_integral.build(buf, _frameW, _frameH, _area, _format)) return false;
+    for (int i = 0; i < _count; i++) means[i] = _integral.mean(_rects[i]);
+    return true;
+  }
+
+  for (int i = 0; i < _count; i++) _sums[i] = 0;
+
+  const SampleSpan *sp = _spans;
+  const SampleSpan *end = _spans + _spanCount;
+  for (; sp < end; sp++) {
+    _sums[sp->owner] += lumaSum(buf + sp->offset, sp->len, _format);
+  }
+
+  for (int i = 0; i < _count; i++) {
+    means[i] = _pixels[i] ? (int)(_sums[i] / _pixels[i]) : 0;
+  }
+  return true;
+}
+
+DriftTracker::~DriftTracker() {
+  free(_colRef);
+  free(_rowRef);
+  free(_colCur);
+  free(_rowCur);
+}
+
+bool DriftTracker::reserve(int w, int h, int radius) {
+  int colNeed = w + 2 * radius, rowNeed = h + 2 * radius;
+  if (colNeed > _colCap) {
+    int16_t *r = (int16_t*)realloc(_colRef, colNeed * sizeof(int16_t));
+    if (r) _colRef = r;
+    uint32_t *c = (uint32_t*)realloc(_colCur, colNeed * sizeof(uint32_t));
+    if (c) _colCur = c;
+    if (!r || !c) return false;
+    _colCap = colNeed;
+  }
+  if (rowNeed > _rowCap) {
+    int16_t *r = (int16_t*)realloc(_rowRef, rowNeed * sizeof(int16_t));
+    if (r) _rowRef = r;
+    uint32_t *c = (uint32_t*)realloc(_rowCur, rowNeed * sizeof(uint32_t));
+    if (c) _rowCur = c;
+    if (!r || !c) return false;
+    _rowCap = rowNeed;
+  }
+  return true;
+}
+
+// Профиль с вычтенным средним; возвращает энергию (сумму квадратов)
+static int64_t centerProfile(const uint32_t *sums, int n, int divisor, int16_t *out) {
+  int32_t total = 0;
+  for (int i = 0; i < n; i++) {
+    out[i] = (int16_t)(sums[i] / divisor);
+    total += out[i];
+  }
+  int mean = total / n;
+  int64_t energy = 0;
+  for (int i = 0; i < n; i++) {
+    out[i] = (int16_t)(out[i] - mean);
+    energy += (int32_t)out[i] * out[i];
+  }
+  return energy;
+}
+
+static uint32_t isqrt64(uint64_t v) {
+  uint64_t r = 0, bit = (uint64_t)1 << 62;
+  while (bit > v) bit >>= 2;
+  while (bit) {
+    if (v >= r + bit) { v -= r + bit; r = (r >> 1) + bit; }
+    else r >>= 1;
+    bit >>= 2;
+  }
+  return (uint32_t)r;
+}
+
+// Лучший сдвиг профиля cur (длина n + 2*radius, центр в radius) относительно
+// эталона ref длины n. Сдвиги вне [lo, hi] пропускаются
+static bool bestShift(const int16_t *ref, int64_t refEnergy, const uint32_t *cur, int n,
+                      int divisor, int radius, int lo, int hi, int &shift, int &score) {
+  bool found = false;
+  for (int s = lo; s <= hi; s++) {
+    const uint32_t *c = cur + radius + s;
+    int32_t total = 0;
+    for (int i = 0; i < n; i++) total += (int32_t)(c[i] / divisor);
+    int mean = total / n;
+    int64_t corr = 0, energy = 0;
+    for (int i = 0; i < n; i++) {
+      int v = (int)(c[i] / divisor) - mean;
+      corr += (int32_t)ref[i] * v;
+      energy += (int32_t)v * v;
+    }
+    uint32_t norm = isqrt64((uint64_t)refEnergy * (uint64_t)energy);
+    if (!norm) continue;
+    int sc = (int)(corr * 1000 / (int64_t)norm);
+    // При равенстве предпочитаем меньший по модулю сдвиг
+    if (!found || sc > score || (sc == score && (s < 0 ? -s : s) < (shift < 0 ? -shift : shift))) {
+      shift = s;
+      score = sc;
+      found = true;
+    }
+  }
+  return found;
+}
+
+bool DriftTracker::capture(const uint8_t *buf, int frameW, int frameH, const Rect &area,
+                           LumaFormat fmt) {
+  _w = _h = 0;
+  Rect a = rectIntersect(area, Rect{0, 0, frameW, frameH});
+  if (a.w < 2 || a.h < 2 || a.w != area.w || a.h != area.h) return false;
+  if (!reserve(a.w, a.h, MAX_RADIUS)) return false;
+
+  for (int x = 0; x < a.w; x++) _colCur[x] = 0;
+  for (int y = 0; y < a.h; y++) {
+    int row = (frameH - 1) - (a.y + y);
+    size_t base = (size_t)row * frameW + a.x;
+    uint32_t rowSum = 0;
+    for (int x = 0; x < a.w; x++) {
+      int v = lumaAt(buf, base + x, fmt);
+      _colCur[x] += v;
+      rowSum += v;
+    }
+    _rowCur[y] = rowSum;
+  }
+  _colEnergy = centerProfile(_colCur, a.w, a.h, _colRef);
+  _rowEnergy = centerProfile(_rowCur, a.h, a.w, _rowRef);
+  _w = a.w;
+  _h = a.h;
+  return true;
+}
+
+bool DriftTracker::track(const uint8_t *buf, int frameW, int frameH, const Rect &area, int radius,
+                         int &dx, int &dy, int &scoreX, int &scoreY, LumaFormat fmt) {
+  dx = dy = 0;
+  scoreX = scoreY = 0;
+  if (!hasTemplate() || area.w != _w || area.h != _h) return false;
+  if (!_colEnergy || !_rowEnergy) return false;
+  if (radius > MAX_RADIUS) radius = MAX_RADIUS;
+  if (radius < 0) radius = 0;
+
+  // Допустимые сдвиги - те, при которых область остаётся в кадре
+  int loX = -radius, hiX = radius, loY = -radius, hiY = radius;
+  if (area.x + loX < 0) loX = -area.x;
+  if (area.x + area.w + hiX > frameW) hiX = frameW - area.x - area.w;
+  if (area.y + loY < 0) loY = -area.y;
+  if (area.y + area.h + hiY > frameH) hiY = frameH - area.y - area.h;
+  if (loX > hiX || loY > hiY) return false;
+
+  // Одно чтение расширенной области: столбцы копятся по строкам области,
+  // строки - по столбцам области
+  int cw = _w + 2 * radius, ch = _h + 2 * radius;
+  for (int i = 0; i < cw; i++) _colCur[i] = 0;
+  for (int i = 0; i < ch; i++) _rowCur[i] = 0;
+  for (int j = loY; j < _h + hiY; j++) {
+    int y = area.y + j;
+    int row = (frameH - 1) - y;
+    bool coreRow = j >= 0 && j < _h;
+    size_t base = (size_t)row * frameW;
+    uint32_t rowSum = 0;
+    for (int i = loX; i < _w + hiX; i++) {
+      int v = lumaAt(buf, base + area.x + i, fmt);
+      if (coreRow) _colCur[i + radius] += v;
+      if (i >= 0 && i < _w) rowSum += v;
+    }
+    _rowCur[j + radius] = rowSum;
+  }
+
+  bool okX = bestShift(_colRef, _colEnergy, _colCur, _w, _h, radius, loX, hiX, dx, scoreX);
+  bool okY = bestShift(_rowRef, _rowEnergy, _rowCur, _h, _w, radius, loY, hiY, dy, scoreY);
+  return okX && okY;
+}
@@ -0,0 +1,234 @@
+#ifndef LUMA_SAMPLER_H
+#define LUMA_SAMPLER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Прямоугольник в координатах дисплея (y = 0 - верх картинки)
+struct Rect { int x,y,w,h; };
+
+// Пересечение двух прямоугольников (w/h = 0, если не пересекаются)
+Rect rectIntersect(const Rect &a, const Rect &b);
+// Наименьший прямоугольник, содержащий оба
+Rect rectUnion(const Rect &a, const Rect &b);
+
+// Перевод координат разметки (полный кадр) в координаты кадра, когда
+// сенсор отдаёт только окно. Пока окно не задано - тождественное.
+struct FrameMapping {
+  Rect window = {0, 0, 0, 0};  // окно в координатах разметки
+  int outW = 0, outH = 0;      // размер кадра, который отдаёт сенсор
+
+  bool active() const { return window.w > 0 && window.h > 0; }
+  Rect map(const Rect &r) const;
+};
+
+// Проективное преобразование плоскости (3x3, m[8] = 1). Используется
+// только при сборке плана выборки, на кадре плавающей точки нет.
+struct Homography {
+  float m[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+
+  // false - точка уходит на бесконечность или за камеру
+  bool apply(float x, float y, float &ox, float &oy) const;
+  // То же преобразование, после которого точка сдвигается / масштабируется
+  Homography translated(float dx, float dy) const;
+  Homography scaled(float sx, float sy) const;
+  // По четырём парам точек src[i] -> dst[i] (x0,y0,x1,y1,...).
+  // false - точки вырождены (три на одной прямой и т.п.)
+  bool fromPoints(const float *src, const float *dst);
+};
+
+// Эталонная формула яркости пикселя RGB565 (0..255)
+static inline int rgb565ToGrayRef(uint16_t pix) {
+  int r5 = (pix >> 11) & 0x1F;
+  int g6 = (pix >> 5) & 0x3F;
+  int b5 = pix & 0x1F;
+  return ((r5*255/31)*30 + (g6*255/63)*59 + (b5*255/31)*11) / 100;
+}
+
+// Вклады каналов в яркость, уже умноженные на 5243 ~ 2^19/100:
+// (sum * 5243) >> 19 == sum / 100 для всех sum <= 25500
+extern uint32_t LUMA_R[32];
+extern uint32_t LUMA_G[64];
+extern uint32_t LUMA_B[32];
+
+// Заполняет таблицы; вызвать один раз до первого кадра
+void initLumaTables();
+
+// Яркость пикселя RGB565 по таблицам, бит в бит совпадает с rgb565ToGrayRef()
+static inline int rgb565ToGray(uint16_t pix) {
+  return (LUMA_R[pix >> 11] + LUMA_G[(pix >> 5) & 0x3F] + LUMA_B[pix & 0x1F]) >> 19;
+}
+
+// Сумма яркостей len подряд идущих пикселей RGB565 (little-endian),
+// по два пикселя на одно 32-битное чтение
+uint32_t lumaSumRGB565(const uint8_t *p, int len);
+
+// Сверяет rgb565ToGray() с эталоном на всех 65536 значениях, возвращает
+// число расхождений
+int lumaSelfTest();
+
+// Формат буфера кадра с точки зрения выборки яркости
+enum LumaFormat : uint8_t {
+  LUMA_RGB565 = 0,  // 2 байта на пиксель, яркость считается по таблицам
+  LUMA_GRAY8,       // 1 байт на пиксель, это и есть яркость
+  LUMA_YUV422       // YUYV, 2 байта на пиксель, используется только Y
+};
+
+static inline int lumaBytesPerPixel(LumaFormat f) { return f == LUMA_GRAY8 ? 1 : 2; }
+
+// Яркость пикселя с номером index в буфере
+static inline int lumaAt(const uint8_t *buf, size_t index, LumaFormat f) {
+  switch (f) {
+    case LUMA_GRAY8:  return buf[index];
+    case LUMA_YUV422: return buf[index * 2];
+    default:          return rgb565ToGray(((const uint16_t*)buf)[index]);
+  }
+}
+
+// Записывает цвет RGB565 в пиксель index; в серых форматах - его яркость
+static inline void lumaPut(uint8_t *buf, size_t index, LumaFormat f, uint16_t color) {
+  switch (f) {
+    case LUMA_GRAY8:  buf[index] = (uint8_t)rgb565ToGray(color); break;
+    case LUMA_YUV422: buf[index * 2] = (uint8_t)rgb565ToGray(color); break;
+    default:          ((uint16_t*)buf)[index] = color; break;
+  }
+}
+
+uint32_t lumaSumGray8(const uint8_t *p, int len);
+uint32_t lumaSumYUV422(const uint8_t *p, int len);
+
+// Сумма яркостей len подряд идущих пикселей, начиная с p
+static inline uint32_t lumaSum(const uint8_t *p, int len, LumaFormat f) {
+  switch (f) {
+    case LUMA_GRAY8:  return lumaSumGray8(p, len);
+    case LUMA_YUV422: return lumaSumYUV422(p, len);
+    default:          return lumaSumRGB565(p, len);
+  }
+}
+
+// Интегральное изображение (summed-area table) яркости по области кадра.
+// Строится один раз на кадр, после чего среднее по любому прямоугольнику
+// внутри области считается за O(1), независимо от его размера.
+class IntegralImage {
+ public:
+  ~IntegralImage();
+
+  // buf - кадр в формате fmt (строки в буфере идут снизу вверх),
+  // area - область в координатах дисплея, обрезается по границам кадра.
+  // false - только если не удалось выделить память под таблицу
+  bool build(const uint8_t *buf, int frameW, int frameH, const Rect &area,
+             LumaFormat fmt = LUMA_RGB565);
+
+  // Средняя яркость по пикселям r, попавшим в область; 0 если таких нет
+  int mean(const Rect &r) const;
+
+  const Rect &area() const { return _area; }
+
+ private:
+  uint32_t *_sum = nullptr;
+  size_t _capacity = 0;
+  Rect _area = {0, 0, 0, 0};
+  int _stride = 0;
+};
+
+// Отрезок строки кадра, целиком лежащий внутри одного прямоугольника
+struct SampleSpan {
+  uint32_t offset;  // смещение первого пикселя в буфере кадра, байты
+  uint16_t len;     // длина в пикселях
+  uint16_t owner;   // номер прямоугольника, которому принадлежит отрезок
+};
+
+// План выборки: разметка, заранее разложенная на отрезки строк буфера.
+// Собирается один раз при изменении геометрии; на каждом кадре остаётся
+// только пройти по плоскому массиву без обрезки, переворота и пересчёта
+// индексов. Если прямоугольники крупные или сильно перекрываются, план
+// переключается на интегральное изображение.
+class SamplingPlan {
+ public:
+  ~SamplingPlan();
+
+  // rects - абсолютные прямоугольники в координатах дисплея, их номер в
+  // массиве становится owner. false - если не хватило памяти
+  bool compile(const Rect *rects, int count, int frameW, int frameH,
+               LumaFormat fmt = LUMA_RGB565);
+
+  // То же для наклонённой камеры: каждый пиксель прямоугольника (в
+  // координатах разметки) переводится через h в пиксель кадра, и план
+  // хранит готовые номера пикселей. Точки вне кадра пропускаются
+  bool compileWarped(const Rect *rects, int count, const Homography &h,
+                     int frameW, int frameH, LumaFormat fmt = LUMA_RGB565);
+
+  // Средние яркости по каждому прямоугольнику: means[0..count-1]
+  bool sample(const uint8_t *buf, int *means);
+
+  bool matches(int frameW, int frameH, LumaFormat fmt) const {
+    return _frameW == frameW && _frameH == frameH && _format == fmt;
+  }
+  int count() const { return _count; }
+  int spanCount() const { return _spanCount; }
+  int pixelCount() const { return _pixelCount; }
+  bool usesIntegral() const { return _useIntegral; }
+  bool warped() const { return _warped; }
+
+ private:
+  bool reserveOwners(int count);
+
+  SampleSpan *_spans = nullptr;
+  int _spanCount = 0;
+  int _spanCapacity = 0;
+  Rect *_rects = nullptr;        // для режима интегрального изображения
+  uint32_t *_pixels = nullptr;   // число пикселей каждого прямоугольника
+  uint32_t *_sums = nullptr;
+  int _count = 0;
+  int _ownerCapacity = 0;
+  int _pixelCount = 0;
+  int _frameW = 0, _frameH = 0;
+  LumaFormat _format = LUMA_RGB565;
+  Rect _area = {0, 0, 0, 0};
+  bool _useIntegral = false;
+  IntegralImage _integral;
+  uint32_t *_points = nullptr;   // номера пикселей кадра, подряд по прямоугольникам
+  int _pointCapacity = 0;
+  bool _warped = false;
+};
+
+// Отслеживание сдвига панели в кадре. Эталон - профили яркости области
+// (средние по столбцам и по строкам, с вычтенным средним). Поиск сдвига -
+// целочисленная нормированная корреляция профилей текущего кадра с эталоном
+// по горизонтали и вертикали отдельно, в пределах ±radius. Стоимость
+// ограничена: одно чтение области, расширенной на radius с каждой стороны,
+// плюс (2*radius+1) * (w+h) умножений.
+class DriftTracker {
+ public:
+  static const int MAX_RADIUS = 16;
+
+  ~DriftTracker();
+
+  // Снимает эталон по области area (координаты дисплея). false - область
+  // пуста после обрезки по кадру или не хватило памяти
+  bool capture(const uint8_t *buf, int frameW, int frameH, const Rect &area,
+               LumaFormat fmt = LUMA_RGB565);
+  void clear() { _w = _h = 0; }
+  bool hasTemplate() const { return _w > 0 && _h > 0; }
+
+  // Ищет, на сколько панель сместилась относительно эталона, если сейчас
+  // её ожидают в area (того же размера, что при capture). Сдвиги, при
+  // которых область выходит за кадр, не рассматриваются. scoreX/scoreY -
+  // корреляция лучшего сдвига, -1000..1000. false - эталона нет или
+  // профиль плоский (не за что зацепиться)
+  bool track(const uint8_t *buf, int frameW, int frameH, const Rect &area, int radius,
+             int &dx, int &dy, int &scoreX, int &scoreY, LumaFormat fmt = LUMA_RGB565);
+
+ private:
+  bool reserve(int w, int h, int radius);
+
+  int16_t *_colRef = nullptr;   // w
+  int16_t *_rowRef = nullptr;   // h
+  uint32_t *_colCur = nullptr;  // w + 2*radius
+  uint32_t *_rowCur = nullptr;  // h + 2*radius
+  int _colCap = 0, _rowCap = 0;
+  int _w = 0, _h = 0;
+  int64_t _colEnergy = 0, _rowEnergy = 0;
+};
+
+#endif
@@ -0,0 +1,47 @@
+#include "SampleScheduler.h"
+
+void SampleScheduler::configure(uint32_t fastMs, uint32_t budgetMs, uint32_t burstMs) {
+  if (fastMs < 10) fastMs = 10;
+  if (budgetMs < fastMs) budgetMs = fastMs;
+  _fastMs = fastMs;
+  _budgetMs = budgetMs;
+  _burstMs = burstMs;
+  if (_period < _fastMs) _period = _fastMs;
+  if (_period > _budgetMs) _period = _budgetMs;
+}
+
+void SampleScheduler::boost(uint32_t now) {
+  _burstUntil = now + _burstMs;
+  _period = _fastMs;
+  _stats.boosts++;
+}
+
+uint32_t SampleScheduler::onSample(uint32_t now, bool active) {
+  if (_hasLast) {
+    uint32_t interval = now - _lastSample;
+    // Среднее с весом 1/8 - сглаживает пачки быстрых чтений
+    _stats.avgIntervalMs = _stats.samples > 1
+        ? (_stats.avgIntervalMs * 7 + interval) / 8 : interval;
+    if (interval > _stats.maxIntervalMs) _stats.maxIntervalMs = interval;
+    if (interval > _budgetMs) _stats.overBudget++;
+  }
+  _lastSample = now;
+  _hasLast = true;
+  _stats.samples++;
+
+  if (active) {
+    _stats.activeSamples++;
+    _burstUntil = now + _burstMs;
+    _period = _fastMs;
+  } else if ((int32_t)(_burstUntil - now) > 0) {
+    _period = _fastMs;
+  } else {
+    _period = (_period * 2 < _budgetMs) ? _period * 2 : _budgetMs;
+  }
+  return _period;
+}
+
+void SampleScheduler::resetStats() {
+  _stats = Stats{0, 0, 0, 0, 0, 0};
+  _hasLast = false;
+}
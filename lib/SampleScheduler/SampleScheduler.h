@@ -0,0 +1,49 @@
+#ifndef SAMPLE_SCHEDULER_H
+#define SAMPLE_SCHEDULER_H
+
+#include <stdint.h>
+
+// Расписание чтений дисплея. После нажатия кнопки или замеченного изменения
+// читаем часто (fastMs), пока не пройдёт burstMs без активности; затем
+// период удваивается с каждым спокойным чтением, но не превышает бюджет
+// задержки budgetMs - за столько изменение на неподвижном дисплее будет
+// замечено в худшем случае. Время - millis(), переполнение учитывается.
+class SampleScheduler {
+ public:
+  struct Stats {
+    uint32_t samples;        // всего чтений
+    uint32_t activeSamples;  // из них с изменением или несошедшимся голосованием
+    uint32_t boosts;         // ускорений по нажатию кнопки
+    uint32_t overBudget;     // интервалов длиннее бюджета
+    uint32_t avgIntervalMs;  // скользящее среднее интервала
+    uint32_t maxIntervalMs;
+  };
+
+  void configure(uint32_t fastMs, uint32_t budgetMs, uint32_t burstMs);
+
+  // Нажатие кнопки: ближайшие burstMs читаем с быстрым периодом
+  void boost(uint32_t now);
+
+  // Отметка о выполненном чтении; active - кадр изменился или значение ещё
+  // не подтверждено. Возвращает задержку до следующего чтения, мс
+  uint32_t onSample(uint32_t now, bool active);
+
+  uint32_t period() const { return _period; }
+  uint32_t fastMs() const { return _fastMs; }
+  uint32_t budgetMs() const { return _budgetMs; }
+  uint32_t burstMs() const { return _burstMs; }
+  const Stats &stats() const { return _stats; }
+  void resetStats();
+
+ private:
+  uint32_t _fastMs = 100;
+  uint32_t _budgetMs = 2000;
+  uint32_t _burstMs = 3000;
+  uint32_t _period = 100;
+  uint32_t _burstUntil = 0;
+  uint32_t _lastSample = 0;
+  bool _hasLast = false;
+  Stats _stats = {0, 0, 0, 0, 0, 0};
+};
+
+#endif
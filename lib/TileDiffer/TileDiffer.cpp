@@ -0,0 +1,84 @@
+#include "TileDiffer.h"
+#include <stdlib.h>
+#include <string.h>
+
+TileDiffer::~TileDiffer() {
+  free(_reference);
+  free(_message);
+}
+
+static void putLE16(uint8_t *p, int v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+bool TileDiffer::resize(const Rect &win) {
+  int cols = (win.w + TILE - 1) / TILE;
+  int rows = (win.h + TILE - 1) / TILE;
+  size_t tiles = (size_t)cols * rows;
+  uint8_t *reference = (uint8_t*)malloc(tiles * TILE * TILE);
+  uint8_t *message = (uint8_t*)malloc(HEADER + tiles * TILE_BYTES);
+  if (!reference || !message) {
+    free(reference);
+    free(message);
+    return false;
+  }
+  free(_reference);
+  free(_message);
+  _reference = reference;
+  _message = message;
+  _win = win;
+  _cols = cols;
+  _rows = rows;
+  return true;
+}
+
+size_t TileDiffer::update(const uint8_t *buf, int frameW, int frameH, LumaFormat fmt,
+                          const Rect &win, bool keyframe, int threshold) {
+  if (win.w <= 0 || win.h <= 0 || win.x < 0 || win.y < 0 ||
+      win.x + win.w > frameW || win.y + win.h > frameH) return 0;
+  if (!_reference || win.x != _win.x || win.y != _win.y || win.w != _win.w || win.h != _win.h) {
+    if (!resize(win)) return 0;
+    keyframe = true;
+  }
+
+  uint8_t *out = _message + HEADER;
+  int changed = 0;
+  for (int ty = 0; ty < _rows; ty++) {
+    for (int tx = 0; tx < _cols; tx++) {
+      uint8_t tile[TILE * TILE];
+      memset(tile, 0, sizeof(tile));
+      int x0 = tx * TILE, w = win.w - x0 < TILE ? win.w - x0 : TILE;
+      int top = ty * TILE, h = win.h - top < TILE ? win.h - top : TILE;
+      for (int r = 0; r < h; r++) {
+        size_t row = (size_t)(frameH - 1 - (win.y + top + r)) * frameW + win.x + x0;
+        for (int c = 0; c < w; c++) tile[r * TILE + c] = lumaAt(buf, row + c, fmt);
+      }
+
+      int index = ty * _cols + tx;
+      uint8_t *ref = _reference + (size_t)index * TILE * TILE;
+      if (!keyframe) {
+        int sad = 0;
+        for (int i = 0; i < TILE * TILE; i++) sad += abs((int)tile[i] - (int)ref[i]);
+        if (sad <= threshold) continue;
+      }
+      memcpy(ref, tile, sizeof(tile));
+      putLE16(out, index);
+      memcpy(out + 2, tile, sizeof(tile));
+      out += TILE_BYTES;
+      changed++;
+    }
+  }
+
+  _keyframe = keyframe;
+  _changed = changed;
+  if (!changed) return 0;
+  _message[0] = keyframe ? 1 : 0;
+  _message[1] = TILE;
+  putLE16(_message + 2, win.x);
+  putLE16(_message + 4, win.y);
+  putLE16(_message + 6, win.w);
+  putLE16(_message + 8, win.h);
+  putLE16(_message + 10, changed);
+  return HEADER + (size_t)changed * TILE_BYTES;
+}
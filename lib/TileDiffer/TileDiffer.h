@@ -0,0 +1,52 @@
+#ifndef TILE_DIFFER_H
+#define TILE_DIFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "LumaSampler.h"
+
+// Поток кадров плитками 8x8 по яркости: в сообщение попадают только
+// плитки окна, заметно изменившиеся с тех пор, как их отправили в прошлый
+// раз (сумма модулей разностей больше порога), либо все - в опорном кадре.
+// Сравнение идёт с отправленным, а не с предыдущим кадром, так что
+// медленный дрейф тоже со временем доходит до клиента. Яркость - та же,
+// что у распознавания (lumaAt). Без Arduino.
+//
+// Сообщение, little-endian:
+//   u8 keyframe, u8 TILE, u16 x, u16 y, u16 w, u16 h (окно в кадре), u16 count,
+//   count раз: u16 номер плитки (строка * столбцов + столбец), TILE*TILE байт
+//   яркости по строкам сверху вниз; точки за краем окна - нули
+class TileDiffer {
+ public:
+  static const int TILE = 8;
+  static const size_t HEADER = 12;
+  static const size_t TILE_BYTES = 2 + TILE * TILE;
+
+  TileDiffer() {}
+  ~TileDiffer();
+  TileDiffer(const TileDiffer &) = delete;
+  TileDiffer &operator=(const TileDiffer &) = delete;
+
+  // Кадр buf (строки снизу вверх) размером frameW x frameH, окно win в
+  // координатах дисплея внутри кадра. Другое окно - всегда опорный кадр.
+  // Возвращает длину message(), 0 - отправлять нечего или не хватило памяти
+  size_t update(const uint8_t *buf, int frameW, int frameH, LumaFormat fmt,
+                const Rect &win, bool keyframe, int threshold);
+
+  const uint8_t *message() const { return _message; }
+  bool keyframe() const { return _keyframe; }
+  int changedTiles() const { return _changed; }
+  int tileCount() const { return _cols * _rows; }
+
+ private:
+  bool resize(const Rect &win);
+
+  Rect _win = { 0, 0, 0, 0 };
+  int _cols = 0, _rows = 0;
+  uint8_t *_reference = nullptr;   // последняя отправленная яркость, TILE*TILE на плитку
+  uint8_t *_message = nullptr;
+  bool _keyframe = false;
+  int _changed = 0;
+};
+
+#endif
@@ -1,21 +1,61 @@
 #include <Arduino.h>
 #include "esp_camera.h"
+#include "img_converters.h"
 #include <WiFi.h>
-#include <WebServer.h>
 #include <ESPAsyncWebServer.h>
+#include <memory>
 #include "DebugLogger.h"
 #include <PubSubClient.h>
 #include <ArduinoJson.h>
 #include <config.h>
 #include "OTAUpdater.h"
+#include "LumaSampler.h"
+#include "FrameBroker.h"
+#include "DigitDecoder.h"
+#include "SampleScheduler.h"
+#include "LayoutCalibrator.h"
+#include "ExposureControl.h"
+#include "DisplayProfile.h"
+#include "FrameCodec.h"
+#include "TileDiffer.h"
+#include <AsyncWebSocket.h>
+#ifdef BAKED_LAYOUT
+#include "baked_layout.h"
+#endif
 
 
-void handleGetLayout();
-void handleSetLayout();
-void handleGetThresholds();
-void handleSetThresholds();
-void handleSetLogging();
-void handleGetLogging();
+void handleGetLayout(AsyncWebServerRequest *request);
+void handleSetLayout(AsyncWebServerRequest *request);
+void collectBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total);
+void handleCalibrate(AsyncWebServerRequest *request);
+const char *applyLayoutJson(JsonDocument &doc);
+void handleGetThresholds(AsyncWebServerRequest *request);
+void handleSetThresholds(AsyncWebServerRequest *request);
+void handleSetLogging(AsyncWebServerRequest *request);
+void handleGetLogging(AsyncWebServerRequest *request);
+void handleGetFormat(AsyncWebServerRequest *request);
+void handleSetFormat(AsyncWebServerRequest *request);
+void handleSetWindow(AsyncWebServerRequest *request);
+void handleSetTracking(AsyncWebServerRequest *request);
+void handleGetHomography(AsyncWebServerRequest *request);
+void handleSetHomography(AsyncWebServerRequest *request);
+void handleGetSampling(AsyncWebServerRequest *request);
+void handleSetSampling(AsyncWebServerRequest *request);
+void handleGetExposure(AsyncWebServerRequest *request);
+void handleSetExposure(AsyncWebServerRequest *request);
+void handleGetDecoder(AsyncWebServerRequest *request);
+void handleSetDecoder(AsyncWebServerRequest *request);
+void handleMjpeg(AsyncWebServerRequest *request);
+void handleGetStreaming(AsyncWebServerRequest *request);
+void handleSetStreaming(AsyncWebServerRequest *request);
+void handleGeometry(AsyncWebServerRequest *request);
+void handleGetJobs(AsyncWebServerRequest *request);
+void exposureBegin();
+void requestFastSampling();
+bool applySensorWindow();
+bool setCaptureFormat(pixformat_t fmt);
+bool runCalibration(bool dry, String &result);
+void onGeometryChanged();
 // ====================== GPIO CONTROL ======================
 const int PIN_PLUS  = 14;   // Кнопка "Плюс"
 const int PIN_MINUS = 13;   // Кнопка "Минус"
@@ -32,14 +72,26 @@ int ROI_H = 70;
 
 // ====================== CAMERA ======================
 #define FRAME_SIZE FRAMESIZE_QQVGA
-#define PIXFORMAT  PIXFORMAT_RGB565
+#define PIXFORMAT  PIXFORMAT_RGB565   // Формат по умолчанию, меняется через /setformat
+
+// Текущий формат захвата: RGB565, GRAYSCALE или YUV422 (используется только Y)
+pixformat_t capturePixFormat = PIXFORMAT;
+bool cameraReady = false;   // драйвер запущен; при переинициализации сенсор трогать нельзя
+
+// Формат буфера для выборки яркости
+inline LumaFormat lumaFormatOf(pixformat_t f) {
+  if (f == PIXFORMAT_GRAYSCALE) return LUMA_GRAY8;
+  if (f == PIXFORMAT_YUV422) return LUMA_YUV422;
+  return LUMA_RGB565;
+}
 
 // ====================== GEOMETRY ======================
-struct Rect { int x,y,w,h; };
-const int DIGITS = 2;
-const int SEGMENTS = 7;
+// Разметка хранится в профилях панелей (DisplayLayout): число цифр,
+// светодиодов и точек меняется через /setlayout. По умолчанию - одна
+// панель: две цифры и пять светодиодов сверху
+const int SEGMENTS = PROFILE_SEGMENTS;
 
-Rect segPos[DIGITS][SEGMENTS] = {
+const Rect DEFAULT_SEGMENTS[2][SEGMENTS] = {
   {
     {57, 37, 6, 3}, 
     {66, 42, 3, 6}, 
@@ -60,7 +112,7 @@ Rect segPos[DIGITS][SEGMENTS] = {
   }
 };
 
-Rect topLEDs[] = {
+const Rect DEFAULT_LEDS[] = {
   {17,12,3,3},
   {42,12,3,3},
   {68,12,3,3},
@@ -68,12 +120,46 @@ Rect topLEDs[] = {
   {120,12,3,3}
 };
 
+DisplayLayout layout;   // под visionMutex
+
+void initDefaultLayout() {
+  PanelProfile main = {};
+  strncpy(main.name, "main", sizeof(main.name) - 1);
+#ifdef BAKED_LAYOUT
+  main.digits = BAKED_DIGITS;
+#else
+  main.digits = 2;
+#endif
+  main.leds = sizeof(DEFAULT_LEDS) / sizeof(DEFAULT_LEDS[0]);
+  if (!layout.configure(&main, 1)) {
+    DEBUG_PRINTLN("⚠️  Layout: out of memory");
+    return;
+  }
+#ifdef BAKED_LAYOUT
+  // Стартовая разметка - вшитая, иначе вшитый декодер не включится
+  BakedDigitSampler::rects(layout.rects());
+  ROI_X = BakedDigitSampler::ROI_X;
+  ROI_Y = BakedDigitSampler::ROI_Y;
+#else
+  for (int d = 0; d < main.digits; d++)
+    for (int sg = 0; sg < SEGMENTS; sg++) layout.segment(d, sg) = DEFAULT_SEGMENTS[d][sg];
+#endif
+  for (int i = 0; i < main.leds; i++) layout.led(i) = DEFAULT_LEDS[i];
+}
+
 int threshSegment = 180;
 int threshLED     = 180;
 
+// Автопорог: на каждом кадре порог считается по гистограмме яркостей
+// сегментов/LED (Otsu), а threshSegment/threshLED остаются запасными
+bool autoThresholds = false;
+int effThreshSegment = 180;   // порог, реально применённый к последнему кадру
+int effThreshLED     = 180;
+
 // ====================== MASK ======================
 // Массив соответствия маски цифрам/символам
 int maskToDigit[128];
+GlyphClassifier glyphs;
 
 // Функция для инициализации таблицы соответствий
 void initMaskMap() {
@@ -91,11 +177,17 @@ void initMaskMap() {
   maskToDigit[0b1111111] = '8'; // 8
   maskToDigit[0b1101111] = '9'; // 9
 
-  // Дополнительные символы
-  maskToDigit[0b0000001] = '-'; // Минус
-  maskToDigit[0b1110110] = 'F'; // Буква F
-  maskToDigit[0b00000001] = '_'; // Нижнее подчёркивание
-  maskToDigit[0b1000000] = '^'; // Верхняя черта (используем ^ для обозначения верхней черты)
+  // Дополнительные символы (бит s - сегмент s цифры: 0 - верхний, 3 - нижний, 6 - средний)
+  maskToDigit[0b1000000] = '-'; // Минус
+  maskToDigit[0b1110001] = 'F'; // Буква F
+  maskToDigit[0b0001000] = '_'; // Нижнее подчёркивание
+  maskToDigit[0b0000001] = '^'; // Верхняя черта (используем ^ для обозначения верхней черты)
+
+  // Те же символы - кандидаты мягкого классификатора
+  glyphs.clear();
+  for (int mask = 0; mask < 128; mask++) {
+    if (maskToDigit[mask] >= 0) glyphs.addGlyph(mask, (char)maskToDigit[mask]);
+  }
 }
 
 // Конфигурация MQTT брокера
@@ -106,6 +198,7 @@ const char* MQTT_TOPIC_DISPLAY = "home/meter/display"; // Значение с с
 const char* MQTT_TOPIC_LEDS = "home/meter/leds";       // Состояния всех светодиодов
 const char* MQTT_TOPIC_LED_PREFIX = "home/meter/led";  // Префикс для топиков каждого
                                                         //  LED (добавляется номер 1-5)
+const char* MQTT_TOPIC_LED_BLINK_SUFFIX = "/blink";     // После номера LED: режим OFF/ON/BLINK и период
 WiFiClient wifiClient;
 PubSubClient mqttClient(wifiClient);
 
@@ -141,98 +234,831 @@ unsigned long buttonReleaseTime[3] = {0, 0, 0}; // [plus, minus, enter]
 bool buttonShouldRelease[3] = {false, false, false};
 
 // ====================== SERVER ======================
-WebServer server(80);
+// Обработчики идут в задаче async_tcp, а не в loop(): медленный клиент не
+// задерживает MQTT, кнопки и чтения. Общее с loop() состояние - под
+// VisionLock или ResultLock
+AsyncWebServer server(80);
 
 // Separate Async server for OTA endpoints (runs on different port)
 AsyncWebServer otaServer(8080);
 
 // ====================== DRAW ======================
-inline void drawBox(uint16_t *buf, int w, Rect r, uint16_t color) {
-  for (int x=r.x; x<r.x+r.w; x++) {
-    if (r.y>=0 && r.y<w) buf[r.y*w + x] = color;
-    if (r.y+r.h>=0 && r.y+r.h<w) buf[(r.y+r.h)*w + x] = color;
+// Холст для разметки: буфер хранит только окно view снятого кадра (в
+// координатах дисплея, y = 0 - верх), строки в буфере снизу вверх, как в
+// кадре. Точки вне окна пропускаются, так что рисовать можно и в вырезке
+struct Canvas {
+  uint8_t *buf;
+  Rect view;
+  LumaFormat fmt;
+
+  void put(int x, int y, uint16_t color) {
+    x -= view.x;
+    y -= view.y;
+    if (x < 0 || y < 0 || x >= view.w || y >= view.h) return;
+    lumaPut(buf, (size_t)(view.h - 1 - y) * view.w + x, fmt, color);
+  }
+};
+
+// Рамка прямоугольника в координатах дисплея
+void drawBox(Canvas &c, Rect r, uint16_t color) {
+  for (int x = r.x; x < r.x + r.w; x++) {
+    c.put(x, r.y, color);
+    c.put(x, r.y + r.h, color);
+  }
+  for (int y = r.y; y < r.y + r.h; y++) {
+    c.put(r.x, y, color);
+    c.put(r.x + r.w, y, color);
+  }
+}
+
+// Отрезок в координатах дисплея
+void drawLine(Canvas &c, int x0, int y0, int x1, int y1, uint16_t color) {
+  int dx = abs(x1 - x0), dy = abs(y1 - y0);
+  int steps = dx > dy ? dx : dy;
+  for (int i = 0; i <= steps; i++) {
+    int x = steps ? x0 + (x1 - x0) * i / steps : x0;
+    int y = steps ? y0 + (y1 - y0) * i / steps : y0;
+    c.put(x, y, color);
+  }
+}
+
+// Прямоугольник разметки после перспективы - четырёхугольник
+void drawWarpedBox(Canvas &c, const Homography &hm, Rect r, uint16_t color) {
+  float cx[4] = { (float)r.x, (float)(r.x + r.w), (float)(r.x + r.w), (float)r.x };
+  float cy[4] = { (float)r.y, (float)r.y, (float)(r.y + r.h), (float)(r.y + r.h) };
+  int px[4], py[4];
+  for (int i = 0; i < 4; i++) {
+    float fx, fy;
+    if (!hm.apply(cx[i], cy[i], fx, fy)) return;
+    px[i] = (int)fx;
+    py[i] = (int)fy;
   }
-  for (int y=r.y; y<r.y+r.h; y++) {
-    if (r.x>=0 && r.x<w) buf[y*w + r.x] = color;
-    if (r.x+r.w>=0 && r.x+r.w<w) buf[y*w + r.x+r.w] = color;
+  for (int i = 0; i < 4; i++) {
+    int j = (i + 1) & 3;
+    drawLine(c, px[i], py[i], px[j], py[j], color);
   }
 }
 
+// Последнее распознанное значение: пишет loop(), читает /pinstatus
 String lastResult = "";
+SemaphoreHandle_t resultMutex = nullptr;
+
+struct ResultLock {
+  ResultLock()  { xSemaphoreTake(resultMutex, portMAX_DELAY); }
+  ~ResultLock() { xSemaphoreGive(resultMutex); }
+};
+
+// Планы выборки, пересобираются при изменении ROI или разметки:
+// сегменты цифр и отдельно светодиоды для частого чтения
+SamplingPlan samplingPlan;
+SamplingPlan ledPlan;
+
+// Вшитая разметка (сборка с -DBAKED_LAYOUT): пока геометрия и кадр
+// совпадают с ней, цифры читаются развёрнутой выборкой BakedDigitSampler,
+// иначе - samplingPlan. /setdecoder?mode=generic оставляет только план
+#ifdef BAKED_LAYOUT
+const bool bakedBuilt = true;
+#else
+const bool bakedBuilt = false;
+#endif
+bool bakedDecoder = bakedBuilt;
+bool bakedValid = false;
+
+// Окно сенсора: ROI и разметка задаются в координатах полного кадра
+// FRAME_SIZE, а frameMap переводит их в координаты того, что реально
+// отдаёт камера, когда сенсор снимает только панель
+bool sensorWindowEnabled = false;
+FrameMapping frameMap;
+
+// Слежение за сдвигом панели: эталон снимается с первого кадра после
+// включения или ручной правки ROI/разметки, дальше ROI_X/ROI_Y подправляются
+// по найденному сдвигу. При окне сенсора не работает - искать негде.
+const int TRACK_EVERY_FRAMES = 40;  // ~2 с при частом чтении светодиодов
+const int TRACK_RADIUS = 4;         // поиск в пределах ±4 пикселей
+const int TRACK_MIN_SCORE = 500;    // корреляция ниже - кадр не похож на эталон (0..1000)
+const int TRACK_CONFIRM = 2;        // проверок подряд с тем же сдвигом до поправки
+const int TRACK_MAX_DRIFT = 16;     // дальше от эталона ROI не уводим, только вручную
+bool driftTracking = false;
+DriftTracker driftTracker;
+int driftX = 0, driftY = 0;         // поправка ROI с момента съёмки эталона
+
+// Абсолютный прямоугольник (ROI + смещение из разметки)
+inline Rect absRect(const Rect &r) {
+  return Rect{ ROI_X + r.x, ROI_Y + r.y, r.w, r.h };
+}
+
+// Тот же прямоугольник в координатах снятого кадра
+inline Rect frameRect(const Rect &r) {
+  return frameMap.map(absRect(r));
+}
+
+// Наклонённая камера: разметка задаётся для ровной панели в координатах ROI,
+// а layoutWarp переводит её точки в кадр (относительно ROI_X/ROI_Y, так что
+// сдвиг ROI двигает и наклонённую разметку)
+bool homographyEnabled = false;
+Homography layoutWarp;
+
+// Полное преобразование: координаты разметки -> пиксели снятого кадра
+Homography frameWarp() {
+  Homography h = layoutWarp.translated(ROI_X, ROI_Y);
+  if (frameMap.active()) {
+    h = h.translated(-frameMap.window.x, -frameMap.window.y)
+         .scaled((float)frameMap.outW / frameMap.window.w, (float)frameMap.outH / frameMap.window.h);
+  }
+  return h;
+}
+
+// Охватывающий прямоугольник элемента разметки в координатах полного кадра
+Rect layoutBounds(const Rect &r) {
+  if (!homographyEnabled) return absRect(r);
+  Homography h = layoutWarp.translated(ROI_X, ROI_Y);
+  float cx[4] = { (float)r.x, (float)(r.x + r.w), (float)(r.x + r.w), (float)r.x };
+  float cy[4] = { (float)r.y, (float)r.y, (float)(r.y + r.h), (float)(r.y + r.h) };
+  Rect box = { 0, 0, 0, 0 };
+  for (int i = 0; i < 4; i++) {
+    float fx, fy;
+    if (!h.apply(cx[i], cy[i], fx, fy)) return absRect(r);
+    box = rectUnion(box, Rect{ (int)fx, (int)fy, 1, 1 });
+  }
+  return box;
+}
+
+void compileSamplingPlan(int frameW, int frameH, LumaFormat fmt) {
+  // При наклоне разметка уходит в план как есть, перспектива считается
+  // только здесь - в таблицу номеров пикселей. Арена разметки уже лежит
+  // так, как нужно планам: сначала сегменты и точки, потом светодиоды
+  int n = layout.digitRectCount();
+  int leds = layout.ledCount();
+#ifdef BAKED_LAYOUT
+  bakedValid = !homographyEnabled && !frameMap.active() &&
+               BakedDigitSampler::matches(frameW, frameH, fmt, ROI_X, ROI_Y, layout.digitRects(), n);
+#endif
+  bool ok;
+  if (homographyEnabled) {
+    Homography h = frameWarp();
+    ok = samplingPlan.compileWarped(layout.digitRects(), n, h, frameW, frameH, fmt) &&
+         ledPlan.compileWarped(layout.ledRects(), leds, h, frameW, frameH, fmt);
+  } else {
+    // Сдвиг на ROI и окно сенсора - во временной копии, только при сборке
+    Rect *rects = (Rect*)malloc(sizeof(Rect) * (n + leds + 1));
+    ok = rects != nullptr;
+    if (ok) {
+      for (int i = 0; i < n + leds; i++) rects[i] = frameRect(layout.rects()[i]);
+      ok = samplingPlan.compile(rects, n, frameW, frameH, fmt) &&
+           ledPlan.compile(rects + n, leds, frameW, frameH, fmt);
+      free(rects);
+    }
+  }
+  if (!ok) {
+    DEBUG_PRINTLN("⚠️  Sampling plan: out of memory");
+    return;
+  }
+  DEBUG_PRINTF("Sampling plan: %d spans, %d px%s%s\n", samplingPlan.spanCount(),
+               samplingPlan.pixelCount(),
+               samplingPlan.warped() ? " (warped)" : samplingPlan.usesIntegral() ? " (integral)" : "",
+               bakedValid ? ", baked layout matches" : "");
+}
+
+// Ожидаемый размер снятого кадра: окно сенсора или полный FRAME_SIZE
+void capturedFrameSize(int &w, int &h) {
+  w = frameMap.active() ? frameMap.outW : resolution[FRAME_SIZE].width;
+  h = frameMap.active() ? frameMap.outH : resolution[FRAME_SIZE].height;
+}
+
+// Пересборка под ожидаемый размер кадра и текущий формат
+void compileSamplingPlan() {
+  int w, h;
+  capturedFrameSize(w, h);
+  compileSamplingPlan(w, h, lumaFormatOf(capturePixFormat));
+}
 
 // ====================== ФУНКЦИИ КАМЕРЫ ======================
-String readDisplay() {
-  camera_fb_t *fb = esp_camera_fb_get();
-  if (!fb) return "ERR_NO_FRAME";
+// Результат одного чтения дисплея, передаётся из задачи камеры в loop()
+// READ_UNCHANGED - кадр не отличается от уже распознанного, результата нет
+enum ReadStatus : uint8_t { READ_OK = 0, READ_NO_FRAME, READ_NO_MEM, READ_UNCHANGED };
+
+struct DisplayReading {
+  ReadStatus status;
+  // Цифры всех панелей, панели через пробел; '?' - нераспознанная цифра,
+  // '.' после цифры - её десятичная точка горит
+  char digits[PROFILE_MAX_DIGITS * 2 + PROFILE_MAX_PANELS];
+  char leds[PROFILE_MAX_LEDS + 1];        // '0'/'1', мигающий светодиод - '1'
+  uint8_t ledMode[PROFILE_MAX_LEDS];      // LedMode по частой выборке
+  uint16_t ledPeriodMs[PROFILE_MAX_LEDS]; // период мигания, 0 - не мигает
+  uint8_t digitCount;
+  uint8_t ledCount;
+  uint32_t decodeUs;
+  uint32_t timestamp;         // millis() момента захвата
+  bool stable;                // последний кадр совпал с результатом голосования, значение можно публиковать
+  uint8_t confidence[PROFILE_MAX_DIGITS]; // уверенность классификатора по каждой цифре, 0..100
+  bool active;                // кадр изменился или голосование ещё не сошлось
+};
+
+// Ниже этой уверенности цифра считается нераспознанной ('?'), а кадр сразу переснимается
+const uint8_t MIN_CONFIDENCE = 50;
+
+uint8_t minConfidence(const DisplayReading &r) {
+  uint8_t c = 100;
+  for (int d = 0; d < r.digitCount; d++) if (r.confidence[d] < c) c = r.confidence[d];
+  return c;
+}
+
+// Голосование по последним кадрам: состояние сегмента/LED меняется, только
+// когда VOTE_AGREE из VOTE_DEPTH кадров за новое значение
+const int VOTE_DEPTH = 3;
+const int VOTE_AGREE = 2;
+TemporalVoter voter;
+AutoThreshold segAutoThresh;
+AutoThreshold ledAutoThresh;
+
+// Светодиоды читаются отдельно и чаще (LED_SAMPLE_MS), чтобы отличать
+// мигание от постоянного свечения
+const uint32_t BLINK_HOLD_MS = 2500;  // без переключений дольше - горит/погас
+BlinkDetector blinkDetector;
+bool ledModesChanged = false;
+
+// Детектор изменений: если ни одна средняя яркость сегментов не ушла дальше
+// допуска, режимы светодиодов прежние, а голосование уже сошлось, кадр не
+// распознаётся и не публикуется
+const int CHANGE_TOLERANCE = 12;
+ChangeDetector changeDetector;
+bool lastReadingConfident = false;
+volatile uint32_t framesDecoded = 0;
+volatile uint32_t framesUnchanged = 0;
+// Выставляется из loop(), когда текущее значение нужно опубликовать заново
+// (например, после переподключения MQTT), даже если кадр не менялся
+volatile bool forceDecode = false;
+
+// Экспозиция и усиление по яркости сегментов вместо AEC/AGC сенсора
+// (/setexposure?loop=0 возвращает встроенную автоматику)
+bool exposureLoop = true;
+ExposureControl exposureCtl;
+
+// Сброс всей истории распознавания (после смены ROI, разметки, порогов или формата)
+void resetDecodeHistory() {
+  voter.reset();
+  changeDetector.reset();
+  blinkDetector.reset();
+  segAutoThresh.reset();
+  ledAutoThresh.reset();
+}
+
+// Размеры истории распознавания по текущему профилю: при старте и после
+// смены числа цифр или светодиодов. Под VisionLock
+void resizeDecodeState() {
+  voter.begin(layout.digitRectCount(), VOTE_DEPTH, VOTE_AGREE);
+  changeDetector.begin(layout.digitRectCount());
+  blinkDetector.begin(layout.ledCount(), BLINK_HOLD_MS);
+}
+
+// Подхватывает сенсор после (пере)инициализации камеры: либо выключает
+// встроенные AEC/AGC и стартует регулировку с текущих значений, либо
+// возвращает их
+void exposureBegin() {
+  if (!cameraReady) return;   // драйвер перезапускается: подхватит initCamera()
+  sensor_t *s = esp_camera_sensor_get();
+  if (!s) return;
+  if (!exposureLoop) {
+    s->set_exposure_ctrl(s, 1);
+    s->set_gain_ctrl(s, 1);
+    return;
+  }
+  ExposureControl::Limits limits;
+  exposureCtl.begin(s->status.aec_value, s->status.agc_gain, limits);
+  s->set_exposure_ctrl(s, 0);
+  s->set_gain_ctrl(s, 0);
+  s->set_aec_value(s, exposureCtl.exposure());
+  s->set_agc_gain(s, exposureCtl.gain());
+}
+
+// Шаг регулировки по средним яркостям сегментов этого кадра. Горящие и
+// погасшие регулятор разделяет сам, порог распознавания здесь не участвует:
+// иначе в тёмной комнате "горящих" нет и поднимать экспозицию не по чему.
+// Вызывается из задачи камеры
+void exposureStep(uint32_t frameTime, const int *means) {
+  if (!exposureLoop) return;
+  if (!exposureCtl.update(millis(), frameTime, means, layout.digitRectCount())) return;
 
-  int w = fb->width;
-  int h = fb->height;
-  String out = "";
+  sensor_t *s = esp_camera_sensor_get();
+  if (!s) return;
+  s->set_aec_value(s, exposureCtl.exposure());
+  s->set_agc_gain(s, exposureCtl.gain());
+  // Яркости до изменения больше не годятся ни для порогов, ни для голосования
+  voter.reset();
+  changeDetector.reset();
+  segAutoThresh.reset();
+  ledAutoThresh.reset();
+}
+
+// Средние яркости сегментов и точек: вшитым декодером, если он включён и
+// геометрия всё ещё вшитая, иначе по плану выборки
+bool sampleDigits(const uint8_t *buf, int *means) {
+#ifdef BAKED_LAYOUT
+  if (bakedDecoder && bakedValid) {
+    BakedDigitSampler::sample(buf, means);
+    return true;
+  }
+#endif
+  return samplingPlan.sample(buf, means);
+}
+
+void readDisplay(const FrameRef &frame, DisplayReading &out) {
+  out.timestamp = frame.timestamp();
+  out.stable = false;
+  out.active = false;
+  memset(out.confidence, 0, sizeof(out.confidence));
+  out.decodeUs = 0;
+  out.digits[0] = 0;
+  out.leds[0] = 0;
+  out.digitCount = 0;
+  out.ledCount = 0;
+  memset(out.ledMode, 0, sizeof(out.ledMode));
+  memset(out.ledPeriodMs, 0, sizeof(out.ledPeriodMs));
+
+  // Окно сенсора не меняет размер кадра; другой размер - кадр не от этой
+  // настройки, разметку на него не наложить
+  if (frameMap.active() && (frame.width() != frameMap.outW || frame.height() != frameMap.outH)) {
+    out.status = READ_NO_FRAME;
+    return;
+  }
+
+  LumaFormat fmt = lumaFormatOf(frame.format());
+  if (!samplingPlan.matches(frame.width(), frame.height(), fmt)) {
+    compileSamplingPlan(frame.width(), frame.height(), fmt);
+  }
+
+  // Массивы - под предельный профиль, на кадре ничего не выделяется
+  const int rects = layout.digitRectCount();
+  int means[PROFILE_MAX_DIGIT_RECTS];
+  unsigned long t0 = micros();
+  bool ok = sampleDigits(frame.buf(), means);
+  out.decodeUs = micros() - t0;
+  if (!ok) { out.status = READ_NO_MEM; return; }
+  exposureStep(out.timestamp, means);
+
+  // Выборка уже дала эскиз кадра; всё остальное нужно, только если он
+  // изменился или голосование ещё не пришло к последнему кадру
+  bool changed = changeDetector.changed(means, CHANGE_TOLERANCE) || ledModesChanged;
+  ledModesChanged = false;
+  if (!changed && voter.settled() && lastReadingConfident && !forceDecode) {
+    framesUnchanged++;
+    out.status = READ_UNCHANGED;
+    return;
+  }
+  framesDecoded++;
+  forceDecode = false;
+  out.active = changed || !voter.settled();
+
+  int segThr = threshSegment;
+  if (autoThresholds) {
+    segAutoThresh.add(means, rects);
+    segThr = segAutoThresh.threshold(threshSegment);
+  }
+  effThreshSegment = segThr;
+
+  uint8_t bits[PROFILE_MAX_DIGIT_RECTS];
+  for (int i = 0; i < rects; i++) bits[i] = means[i] >= segThr;
+  voter.push(bits, means);
 
   // ---- ЦИФРЫ ----
-  for (int d=0; d<DIGITS; d++) {
-    int mask = 0;
-    for (int s=0; s<SEGMENTS; s++) {
-      Rect r = segPos[d][s];
-      int ax = ROI_X + r.x;
-      int ay = ROI_Y + r.y;
-      long sumB = 0; int cnt = 0;
-
-      for(int yy=ay; yy<ay+r.h; yy++){
-        for(int xx=ax; xx<ax+r.w; xx++){
-          if(xx<0||yy<0||xx>=w||yy>=h) continue;
-          int yy2 = (h - 1) - yy;
-          int idx = (yy2 * w + xx) * 2;
-          uint16_t pix = fb->buf[idx] | (fb->buf[idx+1] << 8);
-          
-          int r5 = (pix >> 11) & 0x1F;
-          int g6 = (pix >> 5) & 0x3F;
-          int b5 = pix & 0x1F;
-          
-          int gray = ((r5*255/31)*30 + (g6*255/63)*59 + (b5*255/31)*11) / 100;
-          sumB += gray; cnt++;
-        }
+  // Классификатору - медианы яркостей по окну голосования, а не биты
+  char *text = out.digits;
+  for (int p = 0; p < layout.panelCount(); p++) {
+    const PanelProfile &panel = layout.panel(p);
+    if (p > 0) *text++ = ' ';
+    for (int d = panel.firstDigit; d < panel.firstDigit + panel.digits; d++) {
+      int segMeans[SEGMENTS];
+      for (int s=0; s<SEGMENTS; s++) {
+        segMeans[s] = voter.medianMean(d*SEGMENTS + s);
       }
-      int avg = (cnt > 0) ? (sumB / cnt) : 0;
-      mask |= ((avg >= threshSegment) << s);
+      GlyphMatch m = glyphs.classify(segMeans, SEGMENTS, segThr);
+      *text++ = (m.confidence >= MIN_CONFIDENCE) ? m.symbol : '?';
+      out.confidence[d] = m.confidence;
+      int pt = layout.pointIndex(d);
+      if (pt >= 0 && voter.medianMean(pt) >= segThr) *text++ = '.';
     }
-    int digit = maskToDigit[mask];
-    if (digit < 0) out += "?"; else out += (char)digit;
   }
+  *text = 0;
+  out.digitCount = (uint8_t)layout.digitCount();
+  lastReadingConfident = minConfidence(out) >= MIN_CONFIDENCE;
 
   // ---- LED индикаторы ----
+  // Режимы уже посчитаны частой выборкой (sampleLeds)
+  const int leds = layout.ledCount();
+  for (int i = 0; i < leds; i++) {
+    LedMode m = blinkDetector.mode(i);
+    out.leds[i] = (m == LED_ON || m == LED_BLINK) ? '1' : '0';
+    out.ledMode[i] = m;
+    out.ledPeriodMs[i] = (uint16_t)blinkDetector.periodMs(i);
+  }
+  out.leds[leds] = 0;
+  out.ledCount = (uint8_t)leds;
+  out.stable = voter.settled() && blinkDetector.ready();
+  out.status = READ_OK;
+}
+
+// Частое чтение одних светодиодов: несколько отрезков по 3 пикселя, так что
+// его можно делать на каждом кадре. Вызывается из задачи камеры под VisionLock.
+// true - режим какого-то светодиода изменился
+bool sampleLeds(const FrameRef &frame) {
+  if (frameMap.active() && (frame.width() != frameMap.outW || frame.height() != frameMap.outH)) {
+    return false;
+  }
+  LumaFormat fmt = lumaFormatOf(frame.format());
+  if (!ledPlan.matches(frame.width(), frame.height(), fmt)) {
+    compileSamplingPlan(frame.width(), frame.height(), fmt);
+  }
+
+  const int leds = layout.ledCount();
+  int means[PROFILE_MAX_LEDS];
+  if (!ledPlan.sample(frame.buf(), means)) return false;
+
+  int ledThr = threshLED;
+  if (autoThresholds) {
+    ledAutoThresh.add(means, leds);
+    ledThr = ledAutoThresh.threshold(threshLED);
+  }
+  effThreshLED = ledThr;
+
+  uint8_t bits[PROFILE_MAX_LEDS];
+  for (int i = 0; i < leds; i++) bits[i] = means[i] >= ledThr;
+  if (!blinkDetector.push(frame.timestamp(), bits)) return false;
+  ledModesChanged = true;
+  return true;
+}
+
+// Раз в TRACK_EVERY_FRAMES кадров сверяет панель с эталоном и, если сдвиг
+// подтвердился TRACK_CONFIRM раз подряд, переносит ROI. Под VisionLock.
+void trackDrift(const FrameRef &frame) {
+  static int frames = 0;
+  static int pendingDx = 0, pendingDy = 0, confirmations = 0;
+  if (!driftTracking || sensorWindowEnabled || ++frames < TRACK_EVERY_FRAMES) return;
+  frames = 0;
+
+  LumaFormat fmt = lumaFormatOf(frame.format());
+  Rect area = Rect{ ROI_X, ROI_Y, ROI_W, ROI_H };
+  if (!driftTracker.hasTemplate()) {
+    confirmations = 0;
+    if (driftTracker.capture(frame.buf(), frame.width(), frame.height(), area, fmt)) {
+      DEBUG_PRINTF("Drift tracker: template %dx%d at %d,%d\n", area.w, area.h, area.x, area.y);
+    }
+    return;
+  }
+
+  int dx, dy, scoreX, scoreY;
+  unsigned long t0 = micros();
+  bool ok = driftTracker.track(frame.buf(), frame.width(), frame.height(), area, TRACK_RADIUS,
+                               dx, dy, scoreX, scoreY, fmt);
+  unsigned long us = micros() - t0;
+  if (!ok || scoreX < TRACK_MIN_SCORE || scoreY < TRACK_MIN_SCORE || (dx == 0 && dy == 0)) {
+    confirmations = 0;
+    return;
+  }
+  if (dx != pendingDx || dy != pendingDy || confirmations == 0) {
+    pendingDx = dx;
+    pendingDy = dy;
+    confirmations = 1;
+  } else {
+    confirmations++;
+  }
+  if (confirmations < TRACK_CONFIRM) return;
+  confirmations = 0;
+
+  if (abs(driftX + dx) > TRACK_MAX_DRIFT || abs(driftY + dy) > TRACK_MAX_DRIFT) {
+    DEBUG_PRINTF("Drift tracker: shift %d,%d exceeds limit, ROI left as is\n", dx, dy);
+    return;
+  }
+  ROI_X += dx;
+  ROI_Y += dy;
+  driftX += dx;
+  driftY += dy;
+  DEBUG_PRINTF("Drift tracker: ROI moved by %d,%d to %d,%d (score %d/%d, %lu us)\n",
+               dx, dy, ROI_X, ROI_Y, scoreX, scoreY, us);
+  // Эталон остаётся прежним: он привязан к панели, а не к ROI
+  compileSamplingPlan();
+  changeDetector.reset();
+}
+
+const char *ledModeName(uint8_t m) {
+  if (m == LED_BLINK) return "BLINK";
+  return m == LED_ON ? "ON" : "OFF";
+}
+
+// Строка в прежнем формате "12 | LEDs:10101"
+String formatReading(const DisplayReading &r) {
+  if (r.status == READ_NO_FRAME) return "ERR_NO_FRAME";
+  if (r.status == READ_NO_MEM) return "ERR_NO_MEM";
+  String out = r.digits;
   out += " | LEDs:";
-  for (auto &led : topLEDs) {
-    int ax = ROI_X + led.x;
-    int ay = ROI_Y + led.y;
-    long sumB = 0; int cnt = 0;
-
-    for(int yy=ay; yy<ay+led.h; yy++){
-      for(int xx=ax; xx<ax+led.w; xx++){
-        if(xx<0||yy<0||xx>=w||yy>=h) continue;
-        int yy2 = (h - 1) - yy;
-        int idx = (yy2 * w + xx) * 2;
-        uint16_t pix = fb->buf[idx] | (fb->buf[idx+1] << 8);
-        
-        int gray = (((pix >> 11) & 0x1F)*255/31*30 + 
-                   ((pix >> 5) & 0x3F)*255/63*59 + 
-                   (pix & 0x1F)*255/31*11) / 100;
-        sumB += gray; cnt++;
+  out += r.leds;
+  return out;
+}
+
+// ====================== ЗАДАЧА КАМЕРЫ ======================
+// Захват и распознавание идут в отдельной задаче на APP-ядре с приоритетом
+// выше loop(): медленный HTTP-клиент или переподключение MQTT больше не
+// сдвигают моменты чтения. Результаты уходят в loop() через очередь.
+const uint32_t SAMPLE_FAST_MS = 100;     // ~10 Гц после нажатия кнопки или изменения на дисплее
+const uint32_t SAMPLE_BUDGET_MS = 2000;  // бюджет задержки по умолчанию, меняется через /setsampling
+const uint32_t SAMPLE_BURST_MS = 3000;   // столько держим быстрый период после активности
+const uint32_t LED_SAMPLE_MS = 50;      // 20 Гц - только светодиоды, для детектора мигания
+const uint32_t RESAMPLE_DELAY_MS = 50;   // пересъёмка после неуверенного распознавания
+const int MAX_RESAMPLES = 5;             // подряд, потом снова обычный период
+const UBaseType_t VISION_TASK_PRIORITY = 2;   // loop() работает с приоритетом 1
+const uint32_t VIEWER_MAX_FRAME_AGE_MS = 100; // кадр старше - зритель будит задачу камеры
+const uint32_t VIEWER_WAIT_MS = 300;          // сколько поток MJPEG ждёт нового кадра
+const int FRAME_CACHE_SLOTS = 3;
+
+QueueHandle_t readingQueue = nullptr;
+SemaphoreHandle_t visionMutex = nullptr;   // камера, ROI, разметка, пороги, план
+TaskHandle_t visionTaskHandle = nullptr;
+SampleScheduler sampleScheduler;           // под visionMutex
+volatile bool boostRequested = false;
+
+// Захват мьютекса на время блока; обработчики HTTP меняют геометрию только под ним
+struct VisionLock {
+  VisionLock()  { xSemaphoreTake(visionMutex, portMAX_DELAY); }
+  ~VisionLock() { xSemaphoreGive(visionMutex); }
+};
+
+// Снимает кадр и кладёт его в кэш кадров; буфер камеры отдаётся сразу.
+// Только задача камеры, без VisionLock
+bool captureFrame() {
+  camera_fb_t *fb = esp_camera_fb_get();
+  if (!fb) return false;
+  bool ok = FrameBroker::publish(fb, millis());
+  esp_camera_fb_return(fb);
+  return ok;
+}
+
+// Команды задаче камеры. Переинициализация драйвера, окно сенсора и
+// калибровка занимают сотни миллисекунд и трогают камеру: в обработчике
+// HTTP они держали бы async_tcp. Обработчик ставит команду и сразу
+// отвечает 202 с её номером, задача выполняет её перед следующим кадром,
+// итог - в /jobs. Новая команда того же вида заменяет ещё не начатую
+enum JobKind { JOB_FORMAT = 0, JOB_WINDOW, JOB_CALIBRATE, JOB_COUNT };
+enum JobState : uint8_t { JOB_IDLE = 0, JOB_QUEUED, JOB_RUNNING, JOB_DONE, JOB_FAILED };
+const char *JOB_NAMES[JOB_COUNT] = { "format", "window", "calibrate" };
+const char *JOB_STATE_NAMES[] = { "idle", "queued", "running", "done", "failed" };
+
+struct VisionJob {
+  JobState state = JOB_IDLE;
+  uint32_t id = 0;
+  int arg = 0;      // формат, окно вкл/выкл, dry для калибровки
+  String result;    // JSON итога или текст ошибки
+};
+
+VisionJob jobs[JOB_COUNT];      // под jobsMutex
+uint32_t lastJobId = 0;
+SemaphoreHandle_t jobsMutex = nullptr;
+
+struct JobsLock {
+  JobsLock()  { xSemaphoreTake(jobsMutex, portMAX_DELAY); }
+  ~JobsLock() { xSemaphoreGive(jobsMutex); }
+};
+
+uint32_t queueJob(JobKind kind, int arg) {
+  uint32_t id;
+  {
+    JobsLock lock;
+    VisionJob &job = jobs[kind];
+    job.state = JOB_QUEUED;
+    job.arg = arg;
+    job.result = "";
+    job.id = id = ++lastJobId;
+  }
+  if (visionTaskHandle) xTaskNotifyGive(visionTaskHandle);
+  return id;
+}
+
+// Ответ обработчика HTTP на поставленную команду
+void sendJobQueued(AsyncWebServerRequest *request, JobKind kind, uint32_t id) {
+  String json = "{";
+  json += "\"job\":\"" + String(JOB_NAMES[kind]) + "\",";
+  json += "\"id\":" + String(id);
+  json += "}";
+  request->send(202, "application/json", json);
+}
+
+// Разметка поменялась при включённом окне сенсора - окно ставится заново.
+// Уже стоящую команду окна не трогаем: она и так возьмёт новую разметку
+void queueWindowRefresh() {
+  {
+    JobsLock lock;
+    if (jobs[JOB_WINDOW].state == JOB_QUEUED) return;
+  }
+  queueJob(JOB_WINDOW, 1);
+}
+
+bool runJob(JobKind kind, int arg, String &result) {
+  switch (kind) {
+    case JOB_FORMAT:
+      if (setCaptureFormat((pixformat_t)arg)) return true;
+      result = "Camera reinit failed";
+      return false;
+    case JOB_WINDOW: {
+      {
+        VisionLock lock;
+        sensorWindowEnabled = arg == 1;
       }
+      if (applySensorWindow()) return true;
+      result = "Sensor window not applied";
+      return false;
     }
-    int avg = (cnt > 0) ? sumB / cnt : 0;
-    out += (avg >= threshLED ? '1' : '0');
+    case JOB_CALIBRATE:
+      return runCalibration(arg == 1, result);
+    default:
+      return false;
   }
+}
 
-  esp_camera_fb_return(fb);
-  lastResult = out;
-  return out;
+// Стоящие команды по очереди; вызывается задачей камеры без VisionLock
+void runJobs() {
+  for (int k = 0; k < JOB_COUNT; k++) {
+    uint32_t id;
+    int arg;
+    {
+      JobsLock lock;
+      if (jobs[k].state != JOB_QUEUED) continue;
+      jobs[k].state = JOB_RUNNING;
+      id = jobs[k].id;
+      arg = jobs[k].arg;
+    }
+    String result;
+    unsigned long t0 = millis();
+    bool ok = runJob((JobKind)k, arg, result);
+    DEBUG_PRINTF("Job %s #%u: %s in %lu ms\n", JOB_NAMES[k], (unsigned)id,
+                 ok ? "done" : result.c_str(), millis() - t0);
+    JobsLock lock;
+    // Пока выполнялась, могла встать новая того же вида - её не затираем
+    if (jobs[k].id == id) {
+      jobs[k].state = ok ? JOB_DONE : JOB_FAILED;
+      jobs[k].result = result;
+    }
+  }
+}
+
+// Нажатие кнопки: дисплей сейчас начнёт меняться, читаем его часто.
+// Вызывается из loop() (MQTT) и обработчиков HTTP
+void requestFastSampling() {
+  boostRequested = true;
+  if (visionTaskHandle) xTaskNotifyGive(visionTaskHandle);
+}
+
+// Задача просыпается по расписанию распознавания, по частому расписанию
+// светодиодов или по запросу зрителя (acquireFrame). Каждый кадр снимается
+// один раз и попадает в кэш; светодиоды читаются на каждом кадре, а цифры
+// распознаются только по расписанию.
+void visionTask(void *) {
+  TickType_t nextDecode = xTaskGetTickCount();
+  TickType_t nextLeds = nextDecode;
+  for (;;) {
+    TickType_t now = xTaskGetTickCount();
+    TickType_t next = ((int32_t)(nextLeds - nextDecode) < 0) ? nextLeds : nextDecode;
+    TickType_t wait = ((int32_t)(next - now) > 0) ? next - now : 0;
+    ulTaskNotifyTake(pdTRUE, wait);
+    runJobs();
+    if (boostRequested) {
+      boostRequested = false;
+      VisionLock lock;
+      sampleScheduler.boost(millis());
+      nextDecode = xTaskGetTickCount();
+    }
+    DisplayReading reading = {};
+    bool decodeDue;
+    // Кадр ждём без мьютекса: обработчики HTTP не стоят на VisionLock,
+    // пока сенсор досылает кадр
+    bool captured = captureFrame();
+    {
+      VisionLock lock;
+      // Светодиоды - на каждом снятом кадре, в том числе снятом для зрителя;
+      // смена режима сразу запускает распознавание для публикации
+      if (captured && sampleLeds(FrameBroker::latest())) nextDecode = xTaskGetTickCount();
+      if (captured) trackDrift(FrameBroker::latest());
+      nextLeds = xTaskGetTickCount() + pdMS_TO_TICKS(LED_SAMPLE_MS);
+
+      decodeDue = (int32_t)(xTaskGetTickCount() - nextDecode) >= 0;
+      if (decodeDue) {
+        FrameRef frame = FrameBroker::latest();
+        if (captured && frame) {
+          readDisplay(frame, reading);
+        } else {
+          reading.status = READ_NO_FRAME;
+          reading.timestamp = millis();
+          reading.decodeUs = 0;
+          reading.stable = false;
+          reading.active = false;
+          memset(reading.confidence, 0, sizeof(reading.confidence));
+        }
+
+        uint32_t delayMs = sampleScheduler.onSample(millis(), reading.active);
+        // Неуверенная цифра - переснимаем сразу, не дожидаясь периода
+        static int resamples = 0;
+        if (reading.status == READ_OK && minConfidence(reading) < MIN_CONFIDENCE &&
+            resamples < MAX_RESAMPLES) {
+          resamples++;
+          delayMs = RESAMPLE_DELAY_MS;
+        } else {
+          resamples = 0;
+        }
+        // Отсчёт от текущего момента: долг, если задача отставала, не копится
+        nextDecode = xTaskGetTickCount() + pdMS_TO_TICKS(delayMs);
+      }
+    }
+    if (!decodeDue) continue;
+
+    // Неизменившийся кадр в loop() не передаём: ни строки, ни сравнений для MQTT
+    if (reading.status == READ_UNCHANGED) continue;
+
+    // Если loop() не успевает забирать результаты - выбрасываем самый старый
+    if (xQueueSend(readingQueue, &reading, 0) != pdTRUE) {
+      DisplayReading dropped;
+      xQueueReceive(readingQueue, &dropped, 0);
+      xQueueSend(readingQueue, &reading, 0);
+    }
+  }
+}
+
+// Кадр для обработчика HTTP: последний из кэша, без ожидания - async_tcp
+// обслуживает все соединения, и ждать кадр в нём нельзя. Если кадр старше
+// maxAgeMs, задача камеры будится, и следующий запрос получит свежий.
+// Пустой - кадров ещё не было
+FrameRef cachedFrame(uint32_t maxAgeMs) {
+  FrameRef f = FrameBroker::latest();
+  if ((!f || millis() - f.timestamp() > maxAgeMs) && visionTaskHandle) xTaskNotifyGive(visionTaskHandle);
+  return f;
+}
+
+// Кадр для своей задачи (поток MJPEG) не старше maxAgeMs. Если в кэше
+// только старый, будим задачу камеры и ждём новый; одновременные зрители
+// делят один захват. Вызывать без VisionLock и не из обработчиков HTTP
+FrameRef acquireFrame(uint32_t maxAgeMs) {
+  FrameRef f = FrameBroker::latest();
+  if ((f && millis() - f.timestamp() <= maxAgeMs) || !visionTaskHandle) return f;
+
+  uint32_t seq = f ? f.seq() : 0;
+  f.release();
+  xTaskNotifyGive(visionTaskHandle);
+  unsigned long start = millis();
+  while (millis() - start < VIEWER_WAIT_MS) {
+    vTaskDelay(pdMS_TO_TICKS(5));
+    FrameRef n = FrameBroker::latest();
+    if (n && n.seq() != seq) return n;
+  }
+  return FrameBroker::latest();
+}
+
+void startVisionTask() {
+  int w = resolution[FRAME_SIZE].width, h = resolution[FRAME_SIZE].height;
+  if (!FrameBroker::begin(FRAME_CACHE_SLOTS, (size_t)w * h * 2)) {
+    DEBUG_PRINTLN("⚠️  Frame cache: out of memory");
+  }
+  resizeDecodeState();
+  sampleScheduler.configure(SAMPLE_FAST_MS, SAMPLE_BUDGET_MS, SAMPLE_BURST_MS);
+  readingQueue = xQueueCreate(4, sizeof(DisplayReading));
+  xTaskCreatePinnedToCore(visionTask, "vision", 8192, nullptr,
+                          VISION_TASK_PRIORITY, &visionTaskHandle, APP_CPU_NUM);
 }
 
 // ====================== ОБРАБОТЧИКИ HTTP ======================
 
+// Разметка для обеих страниц: /overlay.js. Четырёхугольники из /geometry
+// в координатах кадра рисуются на холсте поверх картинки
+static const char OVERLAY_JS[] = R"rawliteral(
+// view - какое окно кадра показывает картинка [x, y, w, h]
+function drawGeometry(cv, img, g, view) {
+  cv.width = img.clientWidth;
+  cv.height = img.clientHeight;
+  cv.style.left = (img.offsetLeft + img.clientLeft) + 'px';
+  cv.style.top = (img.offsetTop + img.clientTop) + 'px';
+  const ctx = cv.getContext('2d');
+  ctx.clearRect(0, 0, cv.width, cv.height);
+  if (!g || !view[2] || !view[3]) return;
+  const sx = cv.width / view[2], sy = cv.height / view[3];
+  const quad = (q, color) => {
+    ctx.strokeStyle = color;
+    ctx.beginPath();
+    for (let i = 0; i < 4; i++) ctx.lineTo((q[i*2] - view[0] + 0.5) * sx, (q[i*2+1] - view[1] + 0.5) * sy);
+    ctx.closePath();
+    ctx.stroke();
+  };
+  quad(g.roi, '#0f0');
+  g.segments.forEach(q => quad(q, '#ff0'));
+  g.leds.forEach(q => quad(q, '#f00'));
+}
+
+// Свежая геометрия; ошибки сети молча пропускаем - следующий опрос повторит
+function withGeometry(cb) {
+  fetch('/geometry').then(r => r.json()).then(cb).catch(() => {});
+}
+)rawliteral";
+
+void handleOverlayJs(AsyncWebServerRequest *request) {
+  request->send(200, "application/javascript", OVERLAY_JS);
+}
+
 // Главная страница управления
-void handleRoot() {
+void handleRoot(AsyncWebServerRequest *request) {
   String html = R"rawliteral(
 <!DOCTYPE html>
 <html>
@@ -322,17 +1148,50 @@ void handleRoot() {
           <label>Y: <input id="roiY" type="number" style="width:70px"></label>
           <label style="margin-left:10px;"><input id="roiAuto" type="checkbox"> Auto ROI</label>
             <button onclick="applyROI()" style="margin-left:10px;padding:6px 10px;">Apply</button>
+            <div style="margin-top:8px;">
+              <label><input id="roiWindow" type="checkbox" onchange="applyWindow()"> Sensor window (capture panel only)</label>
+              <label style="margin-left:10px;"><input id="roiTrack" type="checkbox" onchange="applyTracking()"> Track drift</label>
+              <span id="roiDrift" style="margin-left:10px;color:#666;"></span>
+            </div>
+            <div style="margin-top:8px;">
+              <label>ROI corners (TL,TR,BR,BL): <input id="roiCorners" type="text" placeholder="x0,y0,x1,y1,x2,y2,x3,y3" style="width:220px"></label>
+              <button onclick="applyHomography(false)" style="margin-left:10px;padding:6px 10px;">Set Perspective</button>
+              <button onclick="applyHomography(true)" style="margin-left:4px;padding:6px 10px;">Off</button>
+            </div>
             <div style="margin-top:8px;">
               <label>Segment threshold: <input id="threshSeg" type="number" style="width:80px"></label>
               <label style="margin-left:10px;">LED threshold: <input id="threshLed" type="number" style="width:80px"></label>
+              <label style="margin-left:10px;"><input id="threshAuto" type="checkbox"> Auto</label>
               <button onclick="applyThresholds()" style="margin-left:10px;padding:6px 10px;">Set Thresholds</button>
+              <span id="threshEff" style="margin-left:10px;color:#666;"></span>
+            </div>
+            <div style="margin-top:8px;">
+              <label>Capture format:
+                <select id="capFormat" onchange="applyFormat()">
+                  <option value="rgb565">RGB565</option>
+                  <option value="gray">Grayscale</option>
+                  <option value="yuv">YUV422 (Y)</option>
+                </select>
+              </label>
             </div>
         </div>
-        <img src="/frame?roi=1" width="320" id="streamImg">
+        <div style="position:relative; display:inline-block;">
+          <img width="320" id="streamImg">
+          <canvas id="streamOverlay" style="position:absolute; left:0; top:0; pointer-events:none;"></canvas>
+        </div>
       </div>
       
       <div style="margin-top:20px; text-align:left;">
         <h3>Layout Configuration</h3>
+        <p>Panels (digit count, LED count, decimal points):</p>
+        <table id="panelTable" border="1" style="border-collapse:collapse;">
+          <thead><tr><th>Name</th><th>Digits</th><th>LEDs</th><th>DP</th><th></th></tr></thead>
+          <tbody></tbody>
+        </table>
+        <div style="margin-top:8px;">
+          <button onclick="addPanel()" style="padding:6px 10px;">Add Panel</button>
+          <button onclick="applyPanels()" style="padding:6px 10px; margin-left:6px;">Apply Panels</button>
+        </div>
         <p>Edit segment rectangles and top LEDs positions:</p>
         <div>
           <div id="segTables"></div>
@@ -344,12 +1203,14 @@ void handleRoot() {
           <div style="margin-top:8px;">
             <button onclick="applyLayout()" style="padding:6px 10px;">Save Layout</button>
             <button onclick="loadLayout()" style="padding:6px 10px; margin-left:6px;">Reload</button>
+            <button onclick="calibrateLayout()" style="padding:6px 10px; margin-left:6px;" title="All digits must show 8 with all LEDs lit">Calibrate (all 8s, all LEDs on)</button>
           </div>
         </div>
       </div>
     </div>
   </div>
 
+  <script src="/overlay.js"></script>
   <script>
     let updateInterval;
     
@@ -377,9 +1238,20 @@ void handleRoot() {
           document.getElementById('lastResult').textContent = data.last_display || '-';
           
           // Обновляем изображение потока
-          document.getElementById('streamImg').src = `/frame?roi=1&t=${Date.now()}`;
+          updateFrame();
         });
     }
+
+    // Сначала геометрия, потом кадр ровно её окна без разметки: рамки
+    // рисует браузер, и окно кадра всегда совпадает с геометрией
+    function updateFrame() {
+      withGeometry(g => {
+        const img = document.getElementById('streamImg');
+        const [x, y, w, h] = g.window;
+        img.onload = () => drawGeometry(document.getElementById('streamOverlay'), img, g, g.window);
+        img.src = `/frame?x=${x}&y=${y}&w=${w}&h=${h}&overlay=0&t=${Date.now()}`;
+      });
+    }
     
     // Автообновление статуса и изображения
     function startAutoUpdate() {
@@ -396,12 +1268,20 @@ void handleRoot() {
       fetch('/roi').then(r=>r.json()).then(data=>{
         document.getElementById('roiX').value = data.x;
         document.getElementById('roiY').value = data.y;
+        document.getElementById('roiWindow').checked = !!data.window;
+        document.getElementById('roiTrack').checked = !!data.tracking;
+        if (data.tracking) document.getElementById('roiDrift').textContent = `drift: ${data.drift_x}, ${data.drift_y}`;
         // Оставляем Auto unchecked по умолчанию
       }).catch(()=>{});
       // Load thresholds
       fetch('/thresholds').then(r=>r.json()).then(t=>{
         document.getElementById('threshSeg').value = t.seg;
         document.getElementById('threshLed').value = t.led;
+        document.getElementById('threshAuto').checked = !!t.auto;
+        if (t.auto) document.getElementById('threshEff').textContent = `in use: ${t.seg_eff} / ${t.led_eff}`;
+      }).catch(()=>{});
+      fetch('/format').then(r=>r.json()).then(f=>{
+        document.getElementById('capFormat').value = f.fmt;
       }).catch(()=>{});
     });
 
@@ -424,80 +1304,162 @@ void handleRoot() {
     function applyThresholds() {
       const seg = document.getElementById('threshSeg').value;
       const led = document.getElementById('threshLed').value;
-      fetch(`/setthresholds?seg=${seg}&led=${led}`).then(r=>{
+      const auto = document.getElementById('threshAuto').checked ? 1 : 0;
+      fetch(`/setthresholds?seg=${seg}&led=${led}&auto=${auto}`).then(r=>{
         if (r.ok) updateStatus(); else alert('Failed to set thresholds');
       });
     }
 
-    // Layout functions
-    function createSegTable(d) {
-      let html = `<h4>Digit ${d}</h4><table border="1" style="border-collapse:collapse;"><thead><tr><th>#</th><th>X</th><th>Y</th><th>W</th><th>H</th></tr></thead><tbody>`;
-      for (let s=0; s<7; s++) {
-        html += `<tr><td>${s}</td>`+
-                `<td><input id="seg_${d}_${s}_x" type="number" style="width:60px"></td>`+
-                `<td><input id="seg_${d}_${s}_y" type="number" style="width:60px"></td>`+
-                `<td><input id="seg_${d}_${s}_w" type="number" style="width:60px"></td>`+
-                `<td><input id="seg_${d}_${s}_h" type="number" style="width:60px"></td></tr>`;
-      }
-      html += `</tbody></table>`;
-      return html;
+    // Команды камере выполняются в фоне: ответ 202 с номером, итог - в /jobs
+    function waitJob(r) {
+      if (!r.ok) return r.text().then(t=>{ throw new Error(t); });
+      return r.json().then(q=>new Promise((resolve, reject)=>{
+        const poll = ()=>fetch('/jobs').then(r=>r.json()).then(all=>{
+          const j = all[q.job];
+          if (j.id > q.id) return reject(new Error('superseded'));
+          if (j.id < q.id || j.state === 'queued' || j.state === 'running') return setTimeout(poll, 200);
+          if (j.state === 'done') resolve(j); else reject(new Error(j.error));
+        }).catch(()=>setTimeout(poll, 500));
+        poll();
+      }));
+    }
+
+    function applyWindow() {
+      const en = document.getElementById('roiWindow').checked ? 1 : 0;
+      fetch(`/setwindow?en=${en}`).then(waitJob).catch(e=>{
+        alert('Sensor window not applied: ' + e.message);
+        document.getElementById('roiWindow').checked = false;
+      });
+    }
+
+    function applyTracking() {
+      const en = document.getElementById('roiTrack').checked ? 1 : 0;
+      fetch(`/settracking?en=${en}`).then(r=>{
+        if (!r.ok) alert('Failed to switch drift tracking');
+      });
+    }
+
+    function applyHomography(off) {
+      const url = off ? '/sethomography?off=1'
+                      : '/sethomography?pts=' + encodeURIComponent(document.getElementById('roiCorners').value);
+      fetch(url).then(r=>{
+        if (r.ok) updateStatus(); else r.text().then(t=>alert('Failed to set perspective: ' + t));
+      });
+    }
+
+    function applyFormat() {
+      const fmt = document.getElementById('capFormat').value;
+      fetch(`/setformat?fmt=${fmt}`).then(waitJob).then(updateStatus)
+        .catch(e=>alert('Failed to switch capture format: ' + e.message));
+    }
+
+    // Layout functions: таблицы строятся по профилям панелей из /getlayout
+    let panels = [];
+
+    function rectRow(id, label, r) {
+      r = r || {x:0, y:0, w:0, h:0};
+      return `<tr><td>${label}</td>`+
+             `<td><input id="${id}_x" type="number" style="width:60px" value="${r.x}"></td>`+
+             `<td><input id="${id}_y" type="number" style="width:60px" value="${r.y}"></td>`+
+             `<td><input id="${id}_w" type="number" style="width:60px" value="${r.w}"></td>`+
+             `<td><input id="${id}_h" type="number" style="width:60px" value="${r.h}"></td></tr>`;
+    }
+
+    function readRect(id) {
+      return {
+        x: parseInt(document.getElementById(`${id}_x`).value || 0),
+        y: parseInt(document.getElementById(`${id}_y`).value || 0),
+        w: parseInt(document.getElementById(`${id}_w`).value || 0),
+        h: parseInt(document.getElementById(`${id}_h`).value || 0)
+      };
+    }
+
+    function renderPanels() {
+      let html = '';
+      panels.forEach((p, i) => {
+        html += `<tr><td><input id="pn_${i}_name" value="${p.name}" style="width:90px"></td>`+
+                `<td><input id="pn_${i}_digits" type="number" min="0" value="${p.digits}" style="width:50px"></td>`+
+                `<td><input id="pn_${i}_leds" type="number" min="0" value="${p.leds}" style="width:50px"></td>`+
+                `<td><input id="pn_${i}_dp" type="checkbox" ${p.dp ? 'checked' : ''}></td>`+
+                `<td><button onclick="removePanel(${i})">Remove</button></td></tr>`;
+      });
+      document.querySelector('#panelTable tbody').innerHTML = html;
+    }
+
+    function readPanels() {
+      return panels.map((p, i) => ({
+        name: document.getElementById(`pn_${i}_name`).value,
+        digits: parseInt(document.getElementById(`pn_${i}_digits`).value || 0),
+        leds: parseInt(document.getElementById(`pn_${i}_leds`).value || 0),
+        dp: document.getElementById(`pn_${i}_dp`).checked
+      }));
+    }
+
+    function addPanel() {
+      panels = readPanels();
+      panels.push({ name: `panel${panels.length + 1}`, digits: 2, leds: 0, dp: false });
+      renderPanels();
+    }
+
+    function removePanel(i) {
+      panels = readPanels();
+      panels.splice(i, 1);
+      renderPanels();
+    }
+
+    // Меняется только профиль; разметка панелей с прежним именем сохраняется
+    function applyPanels() {
+      fetch('/setlayout', {method:'POST', headers:{'Content-Type':'application/json'}, body: JSON.stringify({ panels: readPanels() })})
+        .then(r=>{ if (r.ok) loadLayout(); else r.text().then(t=>alert('Failed to apply panels: ' + t)); });
     }
 
     function loadLayout() {
       fetch('/getlayout').then(r=>r.json()).then(data=>{
-        // segPos
-        for (let d=0; d < data.segPos.length; d++) {
-          let segs = data.segPos[d];
-          for (let s=0; s<segs.length; s++) {
-            document.getElementById(`seg_${d}_${s}_x`).value = segs[s].x;
-            document.getElementById(`seg_${d}_${s}_y`).value = segs[s].y;
-            document.getElementById(`seg_${d}_${s}_w`).value = segs[s].w;
-            document.getElementById(`seg_${d}_${s}_h`).value = segs[s].h;
+        panels = data.panels;
+        renderPanels();
+        // Сегменты и точки: по таблице на цифру, сквозная нумерация
+        let html = '', d = 0, pt = 0;
+        for (const p of panels) {
+          for (let k = 0; k < p.digits; k++, d++) {
+            html += `<h4>${p.name}: digit ${k}</h4><table border="1" style="border-collapse:collapse;"><thead><tr><th>#</th><th>X</th><th>Y</th><th>W</th><th>H</th></tr></thead><tbody>`;
+            for (let s = 0; s < 7; s++) html += rectRow(`seg_${d}_${s}`, s, data.segPos[d][s]);
+            if (p.dp) { html += rectRow(`dp_${pt}`, 'DP', data.dpPos[pt]); pt++; }
+            html += `</tbody></table>`;
           }
         }
+        document.getElementById('segTables').innerHTML = html;
         // topLEDs
-        let tbody = document.querySelector('#ledTable tbody');
-        tbody.innerHTML = '';
-        for (let i=0; i < data.topLEDs.length; i++) {
-          let l = data.topLEDs[i];
-          let row = document.createElement('tr');
-          row.innerHTML = `<td>${i}</td>`+
-                          `<td><input id="led_${i}_x" type="number" style="width:60px" value="${l.x}"></td>`+
-                          `<td><input id="led_${i}_y" type="number" style="width:60px" value="${l.y}"></td>`+
-                          `<td><input id="led_${i}_w" type="number" style="width:60px" value="${l.w}"></td>`+
-                          `<td><input id="led_${i}_h" type="number" style="width:60px" value="${l.h}"></td>`;
-          tbody.appendChild(row);
-        }
+        let rows = '';
+        for (let i = 0; i < data.topLEDs.length; i++) rows += rectRow(`led_${i}`, i, data.topLEDs[i]);
+        document.querySelector('#ledTable tbody').innerHTML = rows;
       }).catch(e=>{ console.log('loadLayout error', e); });
     }
 
+    // Прямоугольники без "panels" - профиль на устройстве не меняется
     function applyLayout() {
-      let obj = { segPos: [], topLEDs: [] };
-      for (let d=0; d<2; d++) {
+      let obj = { segPos: [], dpPos: [], topLEDs: [] };
+      let digits = 0, points = 0, leds = 0;
+      for (const p of panels) {
+        digits += p.digits;
+        leds += p.leds;
+        if (p.dp) points += p.digits;
+      }
+      for (let d = 0; d < digits; d++) {
         let arr = [];
-        for (let s=0; s<7; s++) {
-          arr.push({
-            x: parseInt(document.getElementById(`seg_${d}_${s}_x`).value || 0),
-            y: parseInt(document.getElementById(`seg_${d}_${s}_y`).value || 0),
-            w: parseInt(document.getElementById(`seg_${d}_${s}_w`).value || 0),
-            h: parseInt(document.getElementById(`seg_${d}_${s}_h`).value || 0)
-          });
-        }
+        for (let s = 0; s < 7; s++) arr.push(readRect(`seg_${d}_${s}`));
         obj.segPos.push(arr);
       }
-      // LEDs
-      let tbody = document.querySelectorAll('#ledTable tbody tr');
-      for (let i=0;i<tbody.length;i++) {
-        obj.topLEDs.push({
-          x: parseInt(document.getElementById(`led_${i}_x`).value || 0),
-          y: parseInt(document.getElementById(`led_${i}_y`).value || 0),
-          w: parseInt(document.getElementById(`led_${i}_w`).value || 0),
-          h: parseInt(document.getElementById(`led_${i}_h`).value || 0)
-        });
-      }
+      for (let i = 0; i < points; i++) obj.dpPos.push(readRect(`dp_${i}`));
+      for (let i = 0; i < leds; i++) obj.topLEDs.push(readRect(`led_${i}`));
 
       fetch('/setlayout', {method:'POST', headers:{'Content-Type':'application/json'}, body: JSON.stringify(obj)})
-        .then(r=>{ if (r.ok) alert('Layout saved'); else alert('Save failed'); });
+        .then(r=>{ if (r.ok) alert('Layout saved'); else r.text().then(t=>alert('Save failed: ' + t)); });
+    }
+
+    function calibrateLayout() {
+      if (!confirm('All digits must show 8 with all LEDs lit. Replace the layout?')) return;
+      fetch('/calibrate').then(waitJob).then(loadLayout)
+        .catch(e=>alert('Calibration failed: ' + e.message));
     }
 
     function toggleLogging() {
@@ -508,22 +1470,18 @@ void handleRoot() {
       }).catch(()=>{ alert('Failed to toggle logging'); });
     }
 
-    // create seg tables and load layout once DOM ready
-    document.addEventListener('DOMContentLoaded', function() {
-      let st = document.getElementById('segTables');
-      st.innerHTML = createSegTable(0) + createSegTable(1);
-      loadLayout();
-    });
+    // build layout tables from the device profiles once DOM ready
+    document.addEventListener('DOMContentLoaded', loadLayout);
   </script>
 </body>
 </html>
 )rawliteral";
   
-  server.send(200, "text/html", html);
+  request->send(200, "text/html", html);
 }
 
 // Страница с потоковым видео (отдельная)
-void handleStream() {
+void handleStream(AsyncWebServerRequest *request) {
   String html = R"rawliteral(
 <!DOCTYPE html>
 <html>
@@ -555,18 +1513,114 @@ void handleStream() {
         <label style="margin-left:10px;"><input id="sRoiAuto" type="checkbox"> Auto ROI</label>
         <button onclick="applyStreamROI()" style="margin-left:10px;padding:6px 10px;">Apply</button>
       </div>
-      <img id="stream" src="/frame?roi=1">
+      <div style="margin-bottom:10px; text-align:left; color:#ccc;">
+        <label>FPS: <input id="sFps" type="number" min="1" max="25" style="width:60px"></label>
+        <label style="margin-left:10px;">Max quality: <input id="sQuality" type="number" min="20" max="100" style="width:60px"></label>
+        <button onclick="applyStreaming()" style="margin-left:10px;padding:6px 10px;">Apply</button>
+        <label style="margin-left:10px;"><input id="sClientOverlay" type="checkbox" onchange="applyOverlayMode()"> Overlay in browser</label>
+        <span id="sStats" style="margin-left:10px;"></span>
+      </div>
+      <div style="position:relative; display:inline-block;">
+        <img id="stream">
+        <canvas id="streamOverlay" style="position:absolute; left:0; top:0; pointer-events:none;"></canvas>
+      </div>
+      <div style="margin-top:10px; text-align:left; color:#ccc;">
+        <button id="tilesBtn" onclick="toggleTiles()" style="padding:6px 10px;">Start tile feed</button>
+        <span id="tilesStats" style="margin-left:10px;"></span><br>
+        <canvas id="tilesCanvas" width="0" height="0" style="width:320px; image-rendering:pixelated; margin-top:6px;"></canvas>
+      </div>
     </div>
   </div>
   
+  <script src="/overlay.js"></script>
   <script>
-    // Автоматическое обновление потока
-    function updateStream() {
-      document.getElementById('stream').src = `/frame?roi=1&t=${Date.now()}`;
+    // Поток MJPEG отдаёт задача потока со своего порта
+    document.getElementById('stream').src = `http://${location.hostname}:81/`;
+
+    // Поток MJPEG идёт по одному соединению; здесь только его статистика
+    // и разметка, когда её рисует браузер
+    function updateStreamStats() {
+      fetch('/streaming').then(r=>r.json()).then(st=>{
+        document.getElementById('sStats').textContent =
+          `quality ${st.quality}, ${st.bytes} bytes, ${st.busy_ms} ms, viewers ${st.viewers}`;
+        const cv = document.getElementById('streamOverlay');
+        const img = document.getElementById('stream');
+        if (st.overlay) {
+          drawGeometry(cv, img, null, [0, 0, 0, 0]);
+          return;
+        }
+        withGeometry(g => drawGeometry(cv, img, g, [0, 0, g.frame[0], g.frame[1]]));
+      }).catch(()=>{});
+    }
+    setInterval(updateStreamStats, 2000);
+
+    fetch('/streaming').then(r=>r.json()).then(st=>{
+      document.getElementById('sFps').value = st.fps;
+      document.getElementById('sQuality').value = st.max_quality;
+      document.getElementById('sClientOverlay').checked = !st.overlay;
+    }).catch(()=>{});
+
+    // Плиточный поток ws://<host>:8080/tiles: яркость окна разметки
+    // плитками 8x8, приходят только изменившиеся - собираем кадр на холсте
+    let tileWs = null, tileImage = null, tileBytes = 0;
+    function toggleTiles() {
+      const btn = document.getElementById('tilesBtn');
+      if (tileWs) {
+        tileWs.close();
+        return;
+      }
+      tileWs = new WebSocket(`ws://${location.hostname}:8080/tiles`);
+      tileWs.binaryType = 'arraybuffer';
+      tileWs.onmessage = ev => onTiles(ev.data);
+      tileWs.onclose = () => { tileWs = null; tileImage = null; btn.textContent = 'Start tile feed'; };
+      btn.textContent = 'Stop tile feed';
+    }
+
+    function onTiles(data) {
+      const v = new DataView(data), px = new Uint8Array(data);
+      const key = v.getUint8(0), tile = v.getUint8(1);
+      const w = v.getUint16(6, true), h = v.getUint16(8, true), count = v.getUint16(10, true);
+      const cv = document.getElementById('tilesCanvas');
+      if (key) {
+        if (!tileImage || tileImage.width !== w || tileImage.height !== h) {
+          cv.width = w;
+          cv.height = h;
+          tileImage = cv.getContext('2d').createImageData(w, h);
+        }
+      } else if (!tileImage || tileImage.width !== w || tileImage.height !== h) {
+        return;   // ждём опорный кадр
+      }
+      const cols = Math.ceil(w / tile);
+      for (let n = 0, p = 12; n < count; n++, p += 2 + tile * tile) {
+        const index = v.getUint16(p, true);
+        const x0 = (index % cols) * tile, y0 = Math.floor(index / cols) * tile;
+        for (let r = 0; r < tile && y0 + r < h; r++) {
+          for (let c = 0; c < tile && x0 + c < w; c++) {
+            const g = px[p + 2 + r * tile + c], o = ((y0 + r) * w + x0 + c) * 4;
+            tileImage.data[o] = tileImage.data[o + 1] = tileImage.data[o + 2] = g;
+            tileImage.data[o + 3] = 255;
+          }
+        }
+      }
+      cv.getContext('2d').putImageData(tileImage, 0, 0);
+      tileBytes += data.byteLength;
+    }
+
+    setInterval(() => {
+      document.getElementById('tilesStats').textContent = tileWs ? `${(tileBytes / 2048).toFixed(1)} KB/s` : '';
+      tileBytes = 0;
+    }, 2000);
+
+    function applyOverlayMode() {
+      const client = document.getElementById('sClientOverlay').checked;
+      fetch(`/setstreaming?overlay=${client ? 0 : 1}`).then(()=>updateStreamStats());
+    }
+
+    function applyStreaming() {
+      const fps = document.getElementById('sFps').value;
+      const q = document.getElementById('sQuality').value;
+      fetch(`/setstreaming?fps=${fps}&quality=${q}`).then(r=>{ if (!r.ok) alert('Failed to set stream parameters'); });
     }
-    
-    // Обновление каждые 100мс для плавного потока
-    setInterval(updateStream, 100);
 
     // Загружаем текущие ROI для полей
     fetch('/roi').then(r=>r.json()).then(data=>{
@@ -583,21 +1637,20 @@ void handleStream() {
       fetch(url).then(r=>{ if (!r.ok) alert('Failed to set ROI'); });
     }
 
-    // Начальное обновление
-    updateStream();
+    updateStreamStats();
   </script>
 </body>
 </html>
 )rawliteral";
   
-  server.send(200, "text/html", html);
+  request->send(200, "text/html", html);
 }
 
 // Обработчик управления пинами (исправленный)
-void handleControl() {
-  if (server.hasArg("pin") && server.hasArg("state")) {
-    String pin = server.arg("pin");
-    bool state = server.arg("state").toInt() == 1;
+void handleControl(AsyncWebServerRequest *request) {
+  if (request->hasArg("pin") && request->hasArg("state")) {
+    String pin = request->arg("pin");
+    bool state = request->arg("state").toInt() == 1;
     
     // Обновляем состояние пинов
     if (pin == "plus") {
@@ -612,63 +1665,64 @@ void handleControl() {
       pinStates[2] = state;
       digitalWrite(PIN_ENTER, state ? HIGH : LOW);
     }
+    if (state) requestFastSampling();
     
-    server.send(200, "text/plain", "OK");
+    request->send(200, "text/plain", "OK");
   } else {
-    server.send(400, "text/plain", "Missing parameters");
+    request->send(400, "text/plain", "Missing parameters");
   }
 }
 
 // JSON статус пинов
-void handlePinStatus() {
+void handlePinStatus(AsyncWebServerRequest *request) {
   String json = "{";
   json += "\"plus\":" + String(pinStates[0] ? "true" : "false") + ",";
   json += "\"minus\":" + String(pinStates[1] ? "true" : "false") + ",";
   json += "\"enter\":" + String(pinStates[2] ? "true" : "false") + ",";
-  json += "\"last_display\":\"" + lastResult + "\"";
+  {
+    ResultLock lock;
+    json += "\"last_display\":\"" + lastResult + "\"";
+  }
   json += "}";
   
-  server.send(200, "application/json", json);
+  request->send(200, "application/json", json);
 }
 
 // Возвращает текущие координаты ROI в JSON
-void handleGetROI() {
+void handleGetROI(AsyncWebServerRequest *request) {
   String json = "{";
   json += "\"x\":" + String(ROI_X) + ",";
   json += "\"y\":" + String(ROI_Y) + ",";
   json += "\"w\":" + String(ROI_W) + ",";
-  json += "\"h\":" + String(ROI_H);
+  json += "\"h\":" + String(ROI_H) + ",";
+  json += "\"window\":" + String(sensorWindowEnabled ? "true" : "false") + ",";
+  json += "\"tracking\":" + String(driftTracking ? "true" : "false") + ",";
+  json += "\"drift_x\":" + String(driftX) + ",";
+  json += "\"drift_y\":" + String(driftY);
   json += "}";
-  server.send(200, "application/json", json);
+  request->send(200, "application/json", json);
 }
 
 // Устанавливает координаты ROI через query-параметры x,y,w,h
-void handleSetROI() {
+void handleSetROI(AsyncWebServerRequest *request) {
+  VisionLock lock;
   bool changed = false;
-  if (server.hasArg("x")) {
-    int v = server.arg("x").toInt(); if (v >= 0) { ROI_X = v; changed = true; }
+  if (request->hasArg("x")) {
+    int v = request->arg("x").toInt(); if (v >= 0) { ROI_X = v; changed = true; }
   }
-  if (server.hasArg("y")) {
-    int v = server.arg("y").toInt(); if (v >= 0) { ROI_Y = v; changed = true; }
+  if (request->hasArg("y")) {
+    int v = request->arg("y").toInt(); if (v >= 0) { ROI_Y = v; changed = true; }
   }
 
   // Если указан auto=1 - вычисляем ширину/высоту автоматически
-  if (server.hasArg("auto") && server.arg("auto").toInt() == 1) {
+  if (request->hasArg("auto") && request->arg("auto").toInt() == 1) {
     int maxX = 0;
     int maxY = 0;
-    // сегменты
-    for (int d = 0; d < DIGITS; d++) {
-      for (int s = 0; s < SEGMENTS; s++) {
-        int ex = segPos[d][s].x + segPos[d][s].w;
-        int ey = segPos[d][s].y + segPos[d][s].h;
-        if (ex > maxX) maxX = ex;
-        if (ey > maxY) maxY = ey;
-      }
-    }
-    // светодиоды
-    for (unsigned int i = 0; i < sizeof(topLEDs)/sizeof(topLEDs[0]); i++) {
-      int ex = topLEDs[i].x + topLEDs[i].w;
-      int ey = topLEDs[i].y + topLEDs[i].h;
+    // сегменты, точки и светодиоды всех панелей
+    for (int i = 0; i < layout.rectCount(); i++) {
+      const Rect &r = layout.rects()[i];
+      int ex = r.x + r.w;
+      int ey = r.y + r.h;
       if (ex > maxX) maxX = ex;
       if (ey > maxY) maxY = ey;
     }
@@ -678,84 +1732,674 @@ void handleSetROI() {
     changed = true;
   } else {
     // Для обратной совместимости можно передать w/h, но UI использует только x/y
-    if (server.hasArg("w")) {
-      int v = server.arg("w").toInt(); if (v > 0) { ROI_W = v; changed = true; }
+    if (request->hasArg("w")) {
+      int v = request->arg("w").toInt(); if (v > 0) { ROI_W = v; changed = true; }
     }
-    if (server.hasArg("h")) {
-      int v = server.arg("h").toInt(); if (v > 0) { ROI_H = v; changed = true; }
+    if (request->hasArg("h")) {
+      int v = request->arg("h").toInt(); if (v > 0) { ROI_H = v; changed = true; }
     }
   }
 
   if (changed) {
-    server.send(200, "text/plain", "OK");
+    onGeometryChanged();
+    request->send(200, "text/plain", "OK");
   } else {
-    server.send(400, "text/plain", "Missing or invalid parameters");
+    request->send(400, "text/plain", "Missing or invalid parameters");
   }
 }
 
-// Обработчик видео (упрощенный)
-void handleFrame() {
-  camera_fb_t *fb = esp_camera_fb_get();
-  if (!fb) {
-    server.send(500, "text/plain", "Camera error");
-    return;
+// Углы прямоугольника разметки (координаты ROI) в снятом кадре по часовой
+// стрелке от левого верхнего: x0,y0,...,x3,y3 - так же, как их рисует
+// drawOverlay(). Под VisionLock
+void overlayCorners(const Rect &r, int *xy) {
+  if (homographyEnabled) {
+    Homography hm = frameWarp();
+    float cx[4] = { (float)r.x, (float)(r.x + r.w), (float)(r.x + r.w), (float)r.x };
+    float cy[4] = { (float)r.y, (float)r.y, (float)(r.y + r.h), (float)(r.y + r.h) };
+    bool ok = true;
+    for (int i = 0; i < 4 && ok; i++) {
+      float fx, fy;
+      ok = hm.apply(cx[i], cy[i], fx, fy);
+      xy[i*2] = (int)fx;
+      xy[i*2 + 1] = (int)fy;
+    }
+    if (ok) return;
   }
+  Rect f = frameRect(r);
+  int q[8] = { f.x, f.y, f.x + f.w, f.y, f.x + f.w, f.y + f.h, f.x, f.y + f.h };
+  memcpy(xy, q, sizeof(q));
+}
 
-  // Всегда рисуем ROI
-  uint16_t *p = (uint16_t*)fb->buf;
-  int H = fb->height;
-  
-  // ROI прямоугольник
-  Rect r = { ROI_X, ROI_Y, ROI_W, ROI_H };
-  r.y = H - (r.y + r.h);
-  drawBox(p, fb->width, r, 0x07E0); // Зеленый
-
-  // Сегменты
-  for (auto &d : segPos) {
-    for (auto &s : d) {
-      Rect r2;
-      r2.x = ROI_X + s.x;
-      r2.y = ROI_Y + s.y;
-      r2.w = s.w;
-      r2.h = s.h;
-      r2.y = H - (r2.y + r2.h);
-      drawBox(p, fb->width, r2, 0xFFE0); // Желтый
-    }
-  }
-
-  // LED индикаторы
-  for (auto &l : topLEDs) {
-    Rect r3;
-    r3.x = ROI_X + l.x;
-    r3.y = ROI_Y + l.y;
-    r3.w = l.w;
-    r3.h = l.h;
-    r3.y = H - (r3.y + r3.h);
-    drawBox(p, fb->width, r3, 0xF800); // Красный
-  }
-
-  // Отправка BMP
-  uint32_t size = 54 + fb->len;
-  uint8_t h[54] = {
-    'B','M',
-    (uint8_t)(size & 0xFF), (uint8_t)((size >> 8) & 0xFF), (uint8_t)((size >> 16) & 0xFF), (uint8_t)((size >> 24) & 0xFF),
-    0,0, 0,0,
-    54,0,0,0,
-    40,0,0,0,
-    (uint8_t)(fb->width & 0xFF), (uint8_t)((fb->width >> 8) & 0xFF), 0,0,
-    (uint8_t)(fb->height & 0xFF), (uint8_t)((fb->height >> 8) & 0xFF), 0,0,
-    1,0, 16,0
-  };
+// Окно /frame?roi=1 в снятом кадре: ROI и вся разметка с полями,
+// без обрезки по кадру. Под VisionLock
+const int FRAME_CROP_MARGIN = 2;
 
-  WiFiClient c = server.client();
-  c.println("HTTP/1.1 200 OK");
-  c.println("Content-Type: image/bmp");
-  c.println("Connection: close");
-  c.println();
-  c.write(h, 54);
-  c.write(fb->buf, fb->len);
+Rect overlayBounds() {
+  Rect win = layoutBounds(Rect{ 0, 0, ROI_W, ROI_H });
+  for (int i = 0; i < layout.rectCount(); i++) win = rectUnion(win, layoutBounds(layout.rects()[i]));
+  win = frameMap.map(win);
+  return Rect{ win.x - FRAME_CROP_MARGIN, win.y - FRAME_CROP_MARGIN,
+               win.w + 2 * FRAME_CROP_MARGIN, win.h + 2 * FRAME_CROP_MARGIN };
+}
 
-  esp_camera_fb_return(fb);
+void quadToJson(JsonArray arr, const Rect &r) {
+  int xy[8];
+  overlayCorners(r, xy);
+  JsonArray q = arr.add<JsonArray>();
+  for (int i = 0; i < 8; i++) q.add(xy[i]);
+}
+
+// /geometry - разметка в координатах снятого кадра, чтобы браузер рисовал
+// её сам поверх /frame?overlay=0 или потока без разметки:
+//   frame: [w, h], window: окно /frame?roi=1 [x, y, w, h],
+//   roi / segments[] / leds[]: четырёхугольники [x0,y0,...,x3,y3]
+void handleGeometry(AsyncWebServerRequest *request) {
+  JsonDocument doc;
+  int W, H;
+  {
+    VisionLock lock;
+    capturedFrameSize(W, H);
+    Rect win = rectIntersect(overlayBounds(), Rect{ 0, 0, W, H });
+    JsonArray frame = doc["frame"].to<JsonArray>();
+    frame.add(W);
+    frame.add(H);
+    JsonArray window = doc["window"].to<JsonArray>();
+    window.add(win.x);
+    window.add(win.y);
+    window.add(win.w);
+    window.add(win.h);
+    doc["warped"] = homographyEnabled;
+
+    int roi[8];
+    overlayCorners(Rect{ 0, 0, ROI_W, ROI_H }, roi);
+    JsonArray roiArr = doc["roi"].to<JsonArray>();
+    for (int i = 0; i < 8; i++) roiArr.add(roi[i]);
+    JsonArray segs = doc["segments"].to<JsonArray>();
+    for (int i = 0; i < layout.digitRectCount(); i++) quadToJson(segs, layout.digitRects()[i]);
+    JsonArray leds = doc["leds"].to<JsonArray>();
+    for (int i = 0; i < layout.ledCount(); i++) quadToJson(leds, layout.ledRects()[i]);
+  }
+
+  String out;
+  serializeJson(doc, out);
+  request->send(200, "application/json", out);
+}
+
+// Разметка поверх кадра: ROI, сегменты и точки, светодиоды. Под VisionLock
+void drawOverlay(Canvas &c) {
+  if (homographyEnabled) {
+    // Наклонённая разметка - четырёхугольниками, как её видит план выборки
+    Homography hm = frameWarp();
+    drawWarpedBox(c, hm, Rect{ 0, 0, ROI_W, ROI_H }, 0x07E0);
+    for (int i = 0; i < layout.digitRectCount(); i++)
+      drawWarpedBox(c, hm, layout.digitRects()[i], 0xFFE0);
+    for (int i = 0; i < layout.ledCount(); i++)
+      drawWarpedBox(c, hm, layout.ledRects()[i], 0xF800);
+  } else {
+    // Всегда рисуем ROI
+    drawBox(c, frameMap.map(Rect{ ROI_X, ROI_Y, ROI_W, ROI_H }), 0x07E0); // Зеленый
+
+    // Сегменты и точки
+    for (int i = 0; i < layout.digitRectCount(); i++)
+      drawBox(c, frameRect(layout.digitRects()[i]), 0xFFE0); // Желтый
+
+    // LED индикаторы
+    for (int i = 0; i < layout.ledCount(); i++)
+      drawBox(c, frameRect(layout.ledRects()[i]), 0xF800); // Красный
+  }
+}
+
+// Окно /frame в координатах снятого кадра: roi=1 - overlayBounds(),
+// иначе x/y/w/h (чего нет - от полного кадра). Пустое - вне кадра
+const int FRAME_MAX_SCALE = 8;
+
+Rect frameCrop(AsyncWebServerRequest *request, int W, int H) {
+  Rect full = { 0, 0, W, H };
+  if (request->hasArg("roi") && request->arg("roi").toInt() == 1) {
+    VisionLock lock;
+    return rectIntersect(overlayBounds(), full);
+  }
+  Rect win = full;
+  if (request->hasArg("x")) win.x = request->arg("x").toInt();
+  if (request->hasArg("y")) win.y = request->arg("y").toInt();
+  win.w = request->hasArg("w") ? request->arg("w").toInt() : W - win.x;
+  win.h = request->hasArg("h") ? request->arg("h").toInt() : H - win.y;
+  return rectIntersect(win, full);
+}
+
+// Строка y (сверху) картинки, уменьшенной в scale раз, из копии окна crop
+// (строки снизу вверх): RGB565 - среднее по каналам квадрата scale x scale,
+// серые форматы - средняя яркость, 1 байт. Остаток от деления размеров
+// окна отбрасывается снизу и справа
+void scaledRow(const uint8_t *win, const Rect &crop, LumaFormat fmt, int scale, int y, uint8_t *out) {
+  const int ow = crop.w / scale;
+  const int area = scale * scale;
+  const bool gray = fmt != LUMA_RGB565;
+  const int base = crop.h - (y + 1) * scale;   // нижняя строка квадрата в копии
+  for (int x = 0; x < ow; x++) {
+    if (scale == 1) {
+      size_t i = (size_t)base * crop.w + x;
+      if (gray) out[x] = lumaAt(win, i, fmt);
+      else memcpy(out + x * 2, win + i * 2, 2);
+      continue;
+    }
+    uint32_t r5 = 0, g6 = 0, b5 = 0, y8 = 0;
+    for (int dy = 0; dy < scale; dy++) {
+      size_t i = (size_t)(base + dy) * crop.w + x * scale;
+      for (int dx = 0; dx < scale; dx++, i++) {
+        if (gray) {
+          y8 += lumaAt(win, i, fmt);
+        } else {
+          uint16_t pix = ((const uint16_t*)win)[i];
+          r5 += pix >> 11;
+          g6 += (pix >> 5) & 0x3F;
+          b5 += pix & 0x1F;
+        }
+      }
+    }
+    if (gray) {
+      out[x] = y8 / area;
+    } else {
+      uint16_t pix = (uint16_t)(((r5 / area) << 11) | ((g6 / area) << 5) | (b5 / area));
+      memcpy(out + x * 2, &pix, 2);
+    }
+  }
+}
+
+// BMP: RGB565 - 16 бит; серые форматы - 8 бит с палитрой. Строки BMP
+// выравниваются до 4 байт и идут снизу вверх
+int bmpRowBytes(int ow, bool gray) {
+  return ((gray ? ow : ow * 2) + 3) & ~3;
+}
+
+uint32_t bmpSize(int ow, int oh, bool gray) {
+  return (gray ? 54 + 1024 : 54) + (uint32_t)bmpRowBytes(ow, gray) * oh;
+}
+
+enum FrameKind { FRAME_BMP = 0, FRAME_QOI, FRAME_PNG };
+
+// Ответ /frame. Копия окна и кодер живут вместе с ответом: сервер сам
+// просит следующую порцию, когда сокет готов её принять, и строки
+// кодируются по мере отправки. В out копится не больше строки и буфера
+// кодера
+struct FrameStream {
+  uint8_t *win = nullptr;    // копия окна кадра, строки снизу вверх
+  Rect crop = { 0, 0, 0, 0 };
+  LumaFormat fmt = LUMA_RGB565;
+  FrameKind kind = FRAME_BMP;
+  int scale = 1, ow = 0, oh = 0;
+  int next = -1;             // следующая строка картинки, -1 - заголовок
+  bool done = false;
+  uint8_t *row = nullptr;    // строка RGB565 (или серая), за ней она же в RGB888
+  uint8_t *out = nullptr;
+  size_t outCap = 0, outLen = 0, outPos = 0;
+  QoiEncoder qoi;
+  PngEncoder png;
+
+  FrameStream() : qoi(append, this), png(append, this) {}
+  ~FrameStream();
+  static size_t append(void *arg, const uint8_t *data, size_t len);
+  bool produce();
+  size_t fill(uint8_t *buf, size_t maxLen);
+};
+
+FrameStream::~FrameStream() {
+  free(win);
+  free(row);
+  free(out);
+}
+
+size_t FrameStream::append(void *arg, const uint8_t *data, size_t len) {
+  FrameStream *st = (FrameStream*)arg;
+  if (st->outPos) {
+    memmove(st->out, st->out + st->outPos, st->outLen - st->outPos);
+    st->outLen -= st->outPos;
+    st->outPos = 0;
+  }
+  if (st->outLen + len > st->outCap) {
+    size_t cap = st->outLen + len + 512;
+    uint8_t *b = (uint8_t*)realloc(st->out, cap);
+    if (!b) return 0;
+    st->out = b;
+    st->outCap = cap;
+  }
+  memcpy(st->out + st->outLen, data, len);
+  st->outLen += len;
+  return len;
+}
+
+// Следующая порция картинки в out; false - картинка кончилась или ошибка
+bool FrameStream::produce() {
+  const bool gray = fmt != LUMA_RGB565;
+  if (next < 0) {
+    next = 0;
+    if (kind == FRAME_QOI) return qoi.begin(ow, oh, gray ? 1 : 3);
+    if (kind == FRAME_PNG) return png.begin(ow, oh, gray ? 1 : 3);
+
+    uint32_t offset = gray ? 54 + 1024 : 54;
+    uint32_t size = bmpSize(ow, oh, gray);
+    uint8_t h[54] = {
+      'B','M',
+      (uint8_t)(size & 0xFF), (uint8_t)((size >> 8) & 0xFF), (uint8_t)((size >> 16) & 0xFF), (uint8_t)((size >> 24) & 0xFF),
+      0,0, 0,0,
+      (uint8_t)(offset & 0xFF), (uint8_t)((offset >> 8) & 0xFF), 0,0,
+      40,0,0,0,
+      (uint8_t)(ow & 0xFF), (uint8_t)((ow >> 8) & 0xFF), 0,0,
+      (uint8_t)(oh & 0xFF), (uint8_t)((oh >> 8) & 0xFF), 0,0,
+      1,0, (uint8_t)(gray ? 8 : 16),0
+    };
+    if (!append(this, h, sizeof(h))) return false;
+    if (gray) {
+      for (int i = 0; i < 256; i++) {
+        uint8_t entry[4] = { (uint8_t)i, (uint8_t)i, (uint8_t)i, 0 };
+        if (!append(this, entry, sizeof(entry))) return false;
+      }
+    }
+    return true;
+  }
+
+  if (next == oh) {
+    done = true;
+    if (kind == FRAME_QOI) return qoi.end();
+    if (kind == FRAME_PNG) return png.end();
+    return false;
+  }
+
+  int y = next++;
+  if (kind == FRAME_BMP) {
+    // Хвост строки row - нули, они и есть выравнивание
+    scaledRow(win, crop, fmt, scale, oh - 1 - y, row);
+    return append(this, row, bmpRowBytes(ow, gray)) != 0;
+  }
+  scaledRow(win, crop, fmt, scale, y, row);
+  const uint8_t *px = row;
+  if (!gray) {
+    uint8_t *rgb = row + bmpRowBytes(ow, false);
+    const uint16_t *src565 = (const uint16_t*)row;
+    for (int x = 0; x < ow; x++) {
+      uint16_t v = src565[x];
+      rgb[x*3] = (v >> 11) * 255 / 31;
+      rgb[x*3 + 1] = ((v >> 5) & 0x3F) * 255 / 63;
+      rgb[x*3 + 2] = (v & 0x1F) * 255 / 31;
+    }
+    px = rgb;
+  }
+  return kind == FRAME_PNG ? png.writeRow(px) : qoi.writeRow(px);
+}
+
+size_t FrameStream::fill(uint8_t *buf, size_t maxLen) {
+  while (outLen - outPos < maxLen && !done) {
+    if (!produce()) done = true;
+  }
+  size_t n = min(maxLen, outLen - outPos);
+  memcpy(buf, out + outPos, n);
+  outPos += n;
+  if (outPos == outLen) outPos = outLen = 0;
+  return n;
+}
+
+// Обработчик видео:
+//   /frame[?roi=1 | x=&y=&w=&h=][&scale=1..8][&overlay=0][&fmt=bmp|qoi|png]
+// Картинка из окна кадра, уменьшенного в scale раз. Из кадра копируется
+// только окно; разметка рисуется в копии, overlay=0 - без неё (браузер
+// рисует сам по /geometry). QOI и PNG - без потерь, сжимаются построчно
+// по мере отправки
+void handleFrame(AsyncWebServerRequest *request) {
+  FrameKind kind = FRAME_BMP;
+  if (request->hasArg("fmt")) {
+    String f = request->arg("fmt");
+    if (f == "qoi") kind = FRAME_QOI;
+    else if (f == "png") kind = FRAME_PNG;
+    else if (f != "bmp") {
+      request->send(400, "text/plain", "fmt must be bmp, qoi or png");
+      return;
+    }
+  }
+
+  FrameRef frame = cachedFrame(VIEWER_MAX_FRAME_AGE_MS);
+  if (!frame) {
+    request->send(503, "text/plain", "No frame yet");
+    return;
+  }
+  const int W = frame.width();
+  const int H = frame.height();
+  LumaFormat fmt = lumaFormatOf(frame.format());
+  const int bpp = lumaBytesPerPixel(fmt);
+
+  Rect crop = frameCrop(request, W, H);
+  int scale = request->hasArg("scale") ? request->arg("scale").toInt() : 1;
+  if (scale < 1) scale = 1;
+  if (scale > FRAME_MAX_SCALE) scale = FRAME_MAX_SCALE;
+  const int ow = crop.w / scale;
+  const int oh = crop.h / scale;
+  if (ow <= 0 || oh <= 0) {
+    request->send(400, "text/plain", "Empty window");
+    return;
+  }
+
+  // Кадр в кэше общий для всех потребителей - разметку рисуем в своей
+  // копии окна. Строки окна в кадре идут подряд (снизу вверх), как и в копии
+  std::shared_ptr<FrameStream> st = std::make_shared<FrameStream>();
+  const size_t cropRow = (size_t)crop.w * bpp;
+  const size_t need = cropRow * crop.h;
+  st->win = (uint8_t*)(psramFound() ? ps_malloc(need) : malloc(need));
+  st->row = (uint8_t*)calloc(bmpRowBytes(ow, false) + ow * 3, 1);
+  if (!st->win || !st->row) {
+    request->send(500, "text/plain", "Out of memory");
+    return;
+  }
+  const uint8_t *src = frame.buf() + ((size_t)(H - crop.y - crop.h) * W + crop.x) * bpp;
+  for (int r = 0; r < crop.h; r++) {
+    memcpy(st->win + r * cropRow, src + (size_t)r * W * bpp, cropRow);
+  }
+  frame.release();
+
+  if (!request->hasArg("overlay") || request->arg("overlay").toInt() != 0) {
+    // Геометрию читаем под тем же мьютексом, под которым её меняют
+    Canvas canvas = { st->win, crop, fmt };
+    VisionLock lock;
+    drawOverlay(canvas);
+  }
+
+  st->crop = crop;
+  st->fmt = fmt;
+  st->kind = kind;
+  st->scale = scale;
+  st->ow = ow;
+  st->oh = oh;
+  AwsResponseFiller filler = [st](uint8_t *buf, size_t maxLen, size_t) { return st->fill(buf, maxLen); };
+  AsyncWebServerResponse *resp;
+  if (kind == FRAME_BMP) {
+    resp = request->beginResponse("image/bmp", bmpSize(ow, oh, fmt != LUMA_RGB565), filler);
+  } else {
+    resp = request->beginChunkedResponse(kind == FRAME_PNG ? "image/png" : "image/qoi", filler);
+  }
+  request->send(resp);
+}
+
+// ====================== MJPEG ======================
+// http://<ip>:81/ - multipart/x-mixed-replace по постоянному соединению
+// (/mjpeg на основном сервере перенаправляет сюда). Сокет слушает сама
+// задача потока: асинхронный сервер умеет только ждать, пока ответ сам
+// попросит данных, и между кадрами опрашивал бы его раз в полсекунды.
+// Задача раз в период берёт кадр из кэша (один захват на всех, заодно его
+// видит детектор светодиодов), рисует разметку, один раз сжимает в JPEG и
+// рассылает всем зрителям. Качество подстраивается, чтобы сжатие и
+// рассылка укладывались в период кадра.
+const uint16_t MJPEG_PORT = 81;
+const uint32_t MJPEG_ACCEPT_POLL_MS = 50;   // пока зрителей нет
+const int MJPEG_MAX_VIEWERS = 4;
+const uint8_t MJPEG_QUALITY_MIN = 20;
+const uint8_t MJPEG_QUALITY_STEP = 5;
+const char *MJPEG_BOUNDARY = "mjpegframe";
+const uint32_t MJPEG_TASK_STACK = 16384;    // кодер JPEG держит таблицы Хаффмана на стеке
+
+WiFiServer mjpegServer(MJPEG_PORT);
+TaskHandle_t mjpegTaskHandle = nullptr;
+volatile uint32_t mjpegPeriodMs = 100;       // 10 кадров/с, меняется через /setstreaming
+volatile uint8_t mjpegMaxQuality = 80;       // потолок подстройки, 1..100 (больше - лучше)
+volatile uint8_t mjpegQuality = 80;          // текущее
+volatile int mjpegViewers = 0;
+volatile uint32_t mjpegFrames = 0;
+volatile uint32_t mjpegLastBytes = 0;
+volatile uint32_t mjpegBusyMs = 0;           // сжатие и рассылка последнего кадра
+volatile bool mjpegOverlay = true;           // false - разметку рисует браузер по /geometry
+
+// JPEG собирается в буфер, который растёт до самого крупного кадра и дальше
+// не перевыделяется
+struct JpegSink {
+  uint8_t *buf;
+  size_t cap;
+  size_t len;
+};
+
+size_t jpegToSink(void *arg, size_t index, const void *data, size_t len) {
+  JpegSink *sink = (JpegSink*)arg;
+  if (index + len > sink->cap) {
+    size_t cap = (index + len) * 3 / 2;
+    uint8_t *b = (uint8_t*)(psramFound() ? ps_realloc(sink->buf, cap) : realloc(sink->buf, cap));
+    if (!b) return 0;
+    sink->buf = b;
+    sink->cap = cap;
+  }
+  memcpy(sink->buf + index, data, len);
+  sink->len = index + len;
+  return len;
+}
+
+// Строки буфера идут снизу вверх, а JPEG - сверху вниз
+void flipRows(uint8_t *buf, size_t rowBytes, int rows, uint8_t *tmp) {
+  for (int top = 0, bottom = rows - 1; top < bottom; top++, bottom--) {
+    uint8_t *a = buf + (size_t)top * rowBytes;
+    uint8_t *b = buf + (size_t)bottom * rowBytes;
+    memcpy(tmp, a, rowBytes);
+    memcpy(a, b, rowBytes);
+    memcpy(b, tmp, rowBytes);
+  }
+}
+
+void mjpegTask(void *) {
+  WiFiClient *viewers[MJPEG_MAX_VIEWERS] = {};
+  int count = 0;
+  uint8_t *scratch = nullptr;
+  size_t scratchSize = 0;
+  uint8_t *rowTmp = nullptr;
+  size_t rowTmpSize = 0;
+  JpegSink jpeg = { nullptr, 0, 0 };
+
+  for (;;) {
+    // Новые зрители: запрос не разбираем, сразу заголовок multipart
+    WiFiClient incoming = mjpegServer.available();
+    if (incoming) {
+      while (incoming.available()) incoming.read();
+      if (count < MJPEG_MAX_VIEWERS) {
+        incoming.setNoDelay(true);
+        incoming.print(String("HTTP/1.1 200 OK\r\n") +
+                       "Content-Type: multipart/x-mixed-replace; boundary=" + MJPEG_BOUNDARY + "\r\n" +
+                       "Cache-Control: no-cache\r\n" +
+                       "Connection: close\r\n\r\n");
+        viewers[count++] = new WiFiClient(incoming);
+      } else {
+        incoming.print("HTTP/1.1 503 Service Unavailable\r\nConnection: close\r\n\r\nToo many viewers");
+        incoming.stop();
+      }
+    }
+    mjpegViewers = count;
+    if (!count) {
+      vTaskDelay(pdMS_TO_TICKS(MJPEG_ACCEPT_POLL_MS));
+      continue;
+    }
+    uint32_t period = mjpegPeriodMs;
+
+    FrameRef frame = acquireFrame(period);
+    if (!frame) {
+      vTaskDelay(pdMS_TO_TICKS(period));
+      continue;
+    }
+    unsigned long start = millis();
+    if (scratchSize < frame.len()) {
+      free(scratch);
+      scratch = (uint8_t*)(psramFound() ? ps_malloc(frame.len()) : malloc(frame.len()));
+      scratchSize = scratch ? frame.len() : 0;
+    }
+    const int W = frame.width();
+    const int H = frame.height();
+    const size_t len = frame.len();
+    const pixformat_t pf = frame.format();
+    const LumaFormat fmt = lumaFormatOf(pf);
+    const size_t rowBytes = (size_t)W * lumaBytesPerPixel(fmt);
+    if (rowTmpSize < rowBytes) {
+      free(rowTmp);
+      rowTmp = (uint8_t*)malloc(rowBytes);
+      rowTmpSize = rowTmp ? rowBytes : 0;
+    }
+    if (!scratch || !rowTmp) {
+      DEBUG_PRINTLN("⚠️  MJPEG: out of memory");
+      vTaskDelay(pdMS_TO_TICKS(period));
+      continue;
+    }
+    memcpy(scratch, frame.buf(), len);
+    frame.release();
+
+    if (mjpegOverlay) {
+      VisionLock lock;
+      Canvas canvas = { scratch, Rect{ 0, 0, W, H }, fmt };
+      drawOverlay(canvas);
+    }
+    flipRows(scratch, rowBytes, H, rowTmp);
+
+    jpeg.len = 0;
+    if (!fmt2jpg_cb(scratch, len, W, H, pf, mjpegQuality, jpegToSink, &jpeg)) {
+      DEBUG_PRINTLN("⚠️  MJPEG: encode failed");
+      vTaskDelay(pdMS_TO_TICKS(period));
+      continue;
+    }
+
+    // Каждому зрителю - одна и та же часть; отвалившиеся закрываются
+    char head[96];
+    int headLen = snprintf(head, sizeof(head),
+                           "--%s\r\nContent-Type: image/jpeg\r\nContent-Length: %u\r\n\r\n",
+                           MJPEG_BOUNDARY, (unsigned)jpeg.len);
+    for (int i = 0; i < count;) {
+      WiFiClient *v = viewers[i];
+      bool sent = v->connected() &&
+                  v->write((const uint8_t*)head, headLen) == (size_t)headLen &&
+                  v->write(jpeg.buf, jpeg.len) == jpeg.len &&
+                  v->write((const uint8_t*)"\r\n", 2) == 2;
+      if (sent) {
+        i++;
+        continue;
+      }
+      v->stop();
+      delete v;
+      viewers[i] = viewers[--count];
+    }
+    mjpegViewers = count;
+    mjpegFrames++;
+    mjpegLastBytes = jpeg.len;
+
+    // Не уложились в период - качество ниже, уложились с запасом вдвое - выше
+    uint32_t busy = millis() - start;
+    mjpegBusyMs = busy;
+    int q = mjpegQuality;
+    if (busy > period) q -= MJPEG_QUALITY_STEP;
+    else if (busy * 2 < period) q += MJPEG_QUALITY_STEP;
+    if (q > mjpegMaxQuality) q = mjpegMaxQuality;
+    if (q < MJPEG_QUALITY_MIN) q = MJPEG_QUALITY_MIN;
+    mjpegQuality = (uint8_t)q;
+
+    if (busy < period) vTaskDelay(pdMS_TO_TICKS(period - busy));
+  }
+}
+
+void startStreamTask() {
+  mjpegServer.begin();
+  // Ниже задачи камеры: поток не должен сдвигать моменты чтения
+  xTaskCreatePinnedToCore(mjpegTask, "mjpeg", MJPEG_TASK_STACK, nullptr,
+                          1, &mjpegTaskHandle, APP_CPU_NUM);
+}
+
+// Поток отдаёт задача потока со своего порта
+void handleMjpeg(AsyncWebServerRequest *request) {
+  request->redirect("http://" + WiFi.localIP().toString() + ":" + String(MJPEG_PORT) + "/");
+}
+
+// Параметры и статистика потока в JSON
+void handleGetStreaming(AsyncWebServerRequest *request) {
+  String json = "{";
+  json += "\"fps\":" + String(1000 / mjpegPeriodMs) + ",";
+  json += "\"max_quality\":" + String(mjpegMaxQuality) + ",";
+  json += "\"quality\":" + String(mjpegQuality) + ",";
+  json += "\"viewers\":" + String(mjpegViewers) + ",";
+  json += "\"frames\":" + String(mjpegFrames) + ",";
+  json += "\"bytes\":" + String(mjpegLastBytes) + ",";
+  json += "\"busy_ms\":" + String(mjpegBusyMs) + ",";
+  json += "\"overlay\":" + String(mjpegOverlay ? "true" : "false");
+  json += "}";
+  request->send(200, "application/json", json);
+}
+
+// /setstreaming?fps=1..25&quality=20..100 (потолок подстройки)&overlay=0|1
+void handleSetStreaming(AsyncWebServerRequest *request) {
+  bool changed = false;
+  if (request->hasArg("overlay")) {
+    mjpegOverlay = request->arg("overlay").toInt() != 0;
+    changed = true;
+  }
+  if (request->hasArg("fps")) {
+    int fps = request->arg("fps").toInt();
+    if (fps >= 1 && fps <= 25) { mjpegPeriodMs = 1000 / fps; changed = true; }
+  }
+  if (request->hasArg("quality")) {
+    int q = request->arg("quality").toInt();
+    if (q >= MJPEG_QUALITY_MIN && q <= 100) {
+      mjpegMaxQuality = q;
+      mjpegQuality = q;
+      changed = true;
+    }
+  }
+  if (changed) {
+    request->send(200, "text/plain", "OK");
+  } else {
+    request->send(400, "text/plain", "Missing or invalid parameters");
+  }
+}
+
+// ====================== TILE FEED ======================
+// ws://<ip>:8080/tiles - яркость окна /frame?roi=1 плитками 8x8 (см.
+// TileDiffer): только изменившиеся плитки, раз в TILE_KEYFRAME_MS и новому
+// клиенту - все. Пока панель не меняется, по сети почти ничего не идёт.
+// Шаг из loop(): кадр берётся из кэша без ожидания, устаревший - будим
+// задачу камеры и ждём следующего шага
+const uint32_t TILE_PERIOD_MS = 200;
+const uint32_t TILE_KEYFRAME_MS = 10000;
+const int TILE_SAD_THRESHOLD = 4 * TileDiffer::TILE * TileDiffer::TILE;  // в среднем 4 уровня на точку
+
+AsyncWebSocket tilesWs("/tiles");
+TileDiffer tileDiffer;
+volatile bool tileKeyframeWanted = true;   // новый клиент - нужен опорный кадр
+
+void tileFeedBegin(AsyncWebServer &srv) {
+  tilesWs.onEvent([](AsyncWebSocket *, AsyncWebSocketClient *, AwsEventType type, void *, uint8_t *, size_t) {
+    if (type == WS_EVT_CONNECT) tileKeyframeWanted = true;
+  });
+  srv.addHandler(&tilesWs);
+}
+
+void tileFeedStep() {
+  static unsigned long lastStep = 0, lastKeyframe = 0;
+  static uint32_t lastSeq = 0;
+  unsigned long now = millis();
+  if (now - lastStep < TILE_PERIOD_MS) return;
+  lastStep = now;
+  tilesWs.cleanupClients();
+  // Очередь отправки кому-то ещё занята - плитки не трогаем, изменения
+  // накопятся и уйдут следующим сообщением
+  if (!tilesWs.count() || !tilesWs.availableForWriteAll()) return;
+
+  FrameRef frame = FrameBroker::latest();
+  if (!frame || now - frame.timestamp() > TILE_PERIOD_MS) {
+    frame.release();
+    if (visionTaskHandle) xTaskNotifyGive(visionTaskHandle);
+    return;
+  }
+  if (frame.seq() == lastSeq) return;
+  lastSeq = frame.seq();
+
+  Rect win;
+  {
+    VisionLock lock;
+    win = rectIntersect(overlayBounds(), Rect{ 0, 0, frame.width(), frame.height() });
+  }
+  bool key = tileKeyframeWanted || now - lastKeyframe >= TILE_KEYFRAME_MS;
+  size_t len = tileDiffer.update(frame.buf(), frame.width(), frame.height(), lumaFormatOf(frame.format()),
+                                 win, key, TILE_SAD_THRESHOLD);
+  frame.release();
+  if (tileDiffer.keyframe()) {
+    tileKeyframeWanted = false;
+    lastKeyframe = now;
+  }
+  if (len) tilesWs.binaryAll(tileDiffer.message(), len);
 }
 
 // Маппинг индикаторов на названия для Home Assistant
@@ -767,6 +2411,29 @@ const char* ledNames[] = {
     "Контактор"         // LED_5 Контактор
 };
 
+// Имя светодиода для Home Assistant; у светодиодов сверх пяти - по номеру
+String ledName(int i) {
+    if (i < (int)(sizeof(ledNames) / sizeof(ledNames[0]))) return ledNames[i];
+    return "LED " + String(i + 1);
+}
+
+// Топик показаний панели p: первая - MQTT_TOPIC_DISPLAY, как раньше,
+// следующие - с номером панели (display2, display3, ...)
+String displayTopic(int p) {
+    if (p == 0) return MQTT_TOPIC_DISPLAY;
+    return String(MQTT_TOPIC_DISPLAY) + (p + 1);
+}
+
+// Публикуются только полностью распознанные показания: цифры и точки
+bool isNumericReading(const String& digits) {
+    bool any = false;
+    for (unsigned int i = 0; i < digits.length(); i++) {
+        if (isDigit(digits[i])) any = true;
+        else if (digits[i] != '.') return false;
+    }
+    return any;
+}
+
 // ====================== ФУНКЦИИ MQTT ======================
 void connectToMqtt() {
     DEBUG_PRINT("Connecting to MQTT...");
@@ -908,16 +2575,29 @@ void publishHomeAssistantDiscovery() {
   const char* availabilityTopic = "home/meter/status";
   const char* deviceId = "esp32_meter_reader";
   
-  // 1. СЕНСОР ДИСПЛЕЯ (исправленная версия)
+  // Сенсоры - по текущему профилю панелей
+  PanelProfile panels[PROFILE_MAX_PANELS];
+  int panelCount, ledCount;
   {
+    VisionLock lock;
+    panelCount = layout.panelCount();
+    for (int p = 0; p < panelCount; p++) panels[p] = layout.panel(p);
+    ledCount = layout.ledCount();
+  }
+  
+  // 1. СЕНСОРЫ ДИСПЛЕЯ (по одному на панель)
+  for (int p = 0; p < panelCount; p++) {
     JsonDocument doc; // Вместо StaticJsonDocument<512>
     
-    doc["name"] = "Показания индикатора";
-    doc["state_topic"] = MQTT_TOPIC_DISPLAY;
+    // Первая панель - под прежними именем и unique_id
+    doc["name"] = p == 0 ? String("Показания индикатора")
+                         : "Показания индикатора (" + String(panels[p].name) + ")";
+    doc["state_topic"] = displayTopic(p);
     doc["unit_of_measurement"] = "";
     doc["value_template"] = "{{ value }}";
     doc["icon"] = "mdi:led-outline";
-    doc["unique_id"] = "esp32_meter_display";
+    doc["unique_id"] = p == 0 ? String("esp32_meter_display")
+                              : "esp32_meter_display_" + String(panels[p].name);
     doc["availability_topic"] = availabilityTopic;
     doc["payload_available"] = "online";
     doc["payload_not_available"] = "offline";
@@ -934,7 +2614,8 @@ void publishHomeAssistantDiscovery() {
     String payload;
     serializeJson(doc, payload);
     
-    String topic = String(MQTT_DISCOVERY_PREFIX) + "/sensor/meter_display/config";
+    String topic = String(MQTT_DISCOVERY_PREFIX) + "/sensor/meter_display" +
+                   (p == 0 ? String("") : "_" + String(panels[p].name)) + "/config";
     
     DEBUG_PRINT("📊 Display sensor (");
     DEBUG_PRINT(payload.length());
@@ -947,18 +2628,18 @@ void publishHomeAssistantDiscovery() {
   }
   
   // 2. СВЕТОДИОДЫ (исправленная версия)
-  const char* ledDeviceClasses[] = {"power", "power", "power", "power", "power"};
   const char* ledIcons[] = {"mdi:radiator", "mdi:water-boiler", "mdi:flash", "mdi:gauge", "mdi:electric-switch"};
+  const int knownIcons = sizeof(ledIcons) / sizeof(ledIcons[0]);
   
-  for (int i = 0; i < 5; i++) {
+  for (int i = 0; i < ledCount; i++) {
     JsonDocument doc; // Вместо StaticJsonDocument<512>
     
-    doc["name"] = ledNames[i];
+    doc["name"] = ledName(i);
     doc["state_topic"] = String(MQTT_TOPIC_LED_PREFIX) + (i + 1);
     doc["payload_on"] = "ON";
     doc["payload_off"] = "OFF";
-    doc["device_class"] = ledDeviceClasses[i];
-    doc["icon"] = ledIcons[i];
+    doc["device_class"] = "power";
+    doc["icon"] = i < knownIcons ? ledIcons[i] : "mdi:led-on";
     doc["unique_id"] = "esp32_meter_led" + String(i + 1);
     doc["availability_topic"] = availabilityTopic;
     doc["payload_available"] = "online";
@@ -975,7 +2656,7 @@ void publishHomeAssistantDiscovery() {
     String topic = String(MQTT_DISCOVERY_PREFIX) + "/binary_sensor/meter_led" + (i + 1) + "/config";
     
     DEBUG_PRINT("💡 ");
-    DEBUG_PRINT(ledNames[i]);
+    DEBUG_PRINT(ledName(i));
     DEBUG_PRINT(" (");
     DEBUG_PRINT(payload.length());
     DEBUG_PRINT("b)... ");
@@ -986,6 +2667,48 @@ void publishHomeAssistantDiscovery() {
     delay(200);
   }
   
+  // 2а. РЕЖИМЫ СВЕТОДИОДОВ (горит / погас / мигает)
+  for (int i = 0; i < ledCount; i++) {
+    JsonDocument doc;
+    String stateTopic = String(MQTT_TOPIC_LED_PREFIX) + (i + 1) + MQTT_TOPIC_LED_BLINK_SUFFIX;
+    
+    doc["name"] = ledName(i) + " (режим)";
+    doc["state_topic"] = stateTopic;
+    doc["value_template"] = "{{ value_json.mode }}";
+    doc["json_attributes_topic"] = stateTopic;
+    doc["device_class"] = "enum";
+    JsonArray options = doc["options"].to<JsonArray>();
+    options.add("OFF");
+    options.add("ON");
+    options.add("BLINK");
+    doc["icon"] = "mdi:led-on";
+    doc["unique_id"] = "esp32_meter_led" + String(i + 1) + "_blink";
+    doc["availability_topic"] = availabilityTopic;
+    doc["payload_available"] = "online";
+    doc["payload_not_available"] = "offline";
+    
+    JsonObject device = doc["device"].to<JsonObject>();
+    device["name"] = DEVICE_NAME;
+    JsonArray identifiers = device["identifiers"].to<JsonArray>();
+    identifiers.add(deviceId);
+    
+    String payload;
+    serializeJson(doc, payload);
+    
+    String topic = String(MQTT_DISCOVERY_PREFIX) + "/sensor/meter_led" + (i + 1) + "_blink/config";
+    
+    DEBUG_PRINT("✨ ");
+    DEBUG_PRINT(ledName(i));
+    DEBUG_PRINT(" mode (");
+    DEBUG_PRINT(payload.length());
+    DEBUG_PRINT("b)... ");
+    
+    bool success = mqttClient.publish(topic.c_str(), payload.c_str(), true);
+    DEBUG_PRINTLN(success ? "✅" : "❌");
+    
+    delay(200);
+  }
+  
   // 3. КНОПКИ УПРАВЛЕНИЯ (исправленная версия)
   const char* buttonNames[] = {"Плюс", "Минус", "Ввод"};
   const char* buttonTopicsSet[] = {
@@ -1039,11 +2762,15 @@ void publishHomeAssistantDiscovery() {
   // 4. ПУБЛИКАЦИЯ НАЧАЛЬНЫХ ДАННЫХ
   DEBUG_PRINTLN("\n📤 Publishing initial data...");
   
-  // Дисплей
-  mqttClient.publish(MQTT_TOPIC_DISPLAY, "00", true);
+  // Дисплей: нули по числу цифр панели
+  for (int p = 0; p < panelCount; p++) {
+    String zeros = "";
+    for (int d = 0; d < panels[p].digits; d++) zeros += '0';
+    if (zeros.length() > 0) mqttClient.publish(displayTopic(p).c_str(), zeros.c_str(), true);
+  }
   
   // Светодиоды
-  for (int i = 1; i <= 5; i++) {
+  for (int i = 1; i <= ledCount; i++) {
     String topic = String(MQTT_TOPIC_LED_PREFIX) + i;
     mqttClient.publish(topic.c_str(), "OFF", true);
   }
@@ -1082,6 +2809,7 @@ void mqttCallback(char* topic, byte* payload, unsigned int length) {
             // Публикуем состояние
             mqttClient.publish(MQTT_TOPIC_RELAY_PLUS_STATE, "ON", true);
             DEBUG_PRINTLN("PLUS button pressed via MQTT");
+            requestFastSampling();
         }
         else if (message == "OFF" || message == "0") {
             digitalWrite(PIN_PLUS, LOW);
@@ -1099,6 +2827,7 @@ void mqttCallback(char* topic, byte* payload, unsigned int length) {
             
             mqttClient.publish(MQTT_TOPIC_RELAY_MINUS_STATE, "ON", true);
             DEBUG_PRINTLN("MINUS button pressed via MQTT");
+            requestFastSampling();
         }
         else if (message == "OFF" || message == "0") {
             digitalWrite(PIN_MINUS, LOW);
@@ -1116,6 +2845,7 @@ void mqttCallback(char* topic, byte* payload, unsigned int length) {
             
             mqttClient.publish(MQTT_TOPIC_RELAY_ENTER_STATE, "ON", true);
             DEBUG_PRINTLN("ENTER button pressed via MQTT");
+            requestFastSampling();
         }
         else if (message == "OFF" || message == "0") {
             digitalWrite(PIN_ENTER, LOW);
@@ -1133,13 +2863,19 @@ void publishMeterData(const String& result) {
     int pipePos = result.indexOf('|');
     
     if (pipePos > 0) {
-        // Цифры с семисегментника
-        String digits = result.substring(0, 2);
-        if (digits.length() == 2 && isDigit(digits[0]) && isDigit(digits[1])) {
-            static String lastDigits = "";
-            if (digits != lastDigits) { // Публикуем только при изменении
-                mqttClient.publish(MQTT_TOPIC_DISPLAY, digits.c_str(), true);
-                lastDigits = digits;
+        // Цифры с семисегментника: панели через пробел, каждая в свой топик
+        String digitsPart = result.substring(0, pipePos - 1);
+        static String lastDigits[PROFILE_MAX_PANELS];
+        int start = 0;
+        for (int p = 0; p < PROFILE_MAX_PANELS && start <= (int)digitsPart.length(); p++) {
+            int end = digitsPart.indexOf(' ', start);
+            if (end < 0) end = digitsPart.length();
+            String digits = digitsPart.substring(start, end);
+            start = end + 1;
+            if (!isNumericReading(digits)) continue;
+            if (digits != lastDigits[p]) { // Публикуем только при изменении
+                mqttClient.publish(displayTopic(p).c_str(), digits.c_str(), true);
+                lastDigits[p] = digits;
                 DEBUG_PRINTLN("Published digits: " + digits);
             }
         }
@@ -1150,9 +2886,9 @@ void publishMeterData(const String& result) {
             int ledsStart = ledsPart.indexOf("LEDs:") + 5;
             String ledStates = ledsPart.substring(ledsStart);
             
-            static String lastLedStates[5] = {"", "", "", "", ""};
+            static String lastLedStates[PROFILE_MAX_LEDS];
             
-            for (int i = 0; i < 5 && i < ledStates.length(); i++) {
+            for (int i = 0; i < PROFILE_MAX_LEDS && i < (int)ledStates.length(); i++) {
                 String topic = String(MQTT_TOPIC_LED_PREFIX) + (i + 1);
                 String state = (ledStates[i] == '1') ? "ON" : "OFF";
                 
@@ -1163,7 +2899,7 @@ void publishMeterData(const String& result) {
                     DEBUG_PRINT("LED");
                     DEBUG_PRINT(i + 1);
                     DEBUG_PRINT(" (");
-                    DEBUG_PRINT(ledNames[i]);
+                    DEBUG_PRINT(ledName(i));
                     DEBUG_PRINT("): ");
                     DEBUG_PRINTLN(state);
                 }
@@ -1172,6 +2908,34 @@ void publishMeterData(const String& result) {
     }
 }
 
+// Режимы светодиодов по детектору мигания: {"mode":"BLINK","period_ms":800}
+// в <префикс>N/blink, только при изменении
+void publishLedModes(const DisplayReading& r) {
+    if (!mqttClient.connected()) return;
+    
+    static uint8_t lastMode[PROFILE_MAX_LEDS];
+    static uint16_t lastPeriod[PROFILE_MAX_LEDS];
+    static bool havePublished[PROFILE_MAX_LEDS] = {false};
+    
+    for (int i = 0; i < r.ledCount; i++) {
+        if (havePublished[i] && r.ledMode[i] == lastMode[i] && r.ledPeriodMs[i] == lastPeriod[i]) continue;
+        
+        String topic = String(MQTT_TOPIC_LED_PREFIX) + (i + 1) + MQTT_TOPIC_LED_BLINK_SUFFIX;
+        String payload = "{\"mode\":\"" + String(ledModeName(r.ledMode[i])) +
+                         "\",\"period_ms\":" + String(r.ledPeriodMs[i]) + "}";
+        if (mqttClient.publish(topic.c_str(), payload.c_str(), true)) {
+            lastMode[i] = r.ledMode[i];
+            lastPeriod[i] = r.ledPeriodMs[i];
+            havePublished[i] = true;
+            
+            DEBUG_PRINT("LED");
+            DEBUG_PRINT(i + 1);
+            DEBUG_PRINT(" mode: ");
+            DEBUG_PRINTLN(payload);
+        }
+    }
+}
+
 void checkSystemHealth() {
     static unsigned long lastHeapCheck = 0;
     
@@ -1190,24 +2954,13 @@ void checkSystemHealth() {
     }
 }
 
-// ====================== SETUP ======================
-void setup() {
-  Serial.begin(115200);
-  DEBUG_PRINTLN("\n\nESP32-CAM Starting...");
-  
-  initMaskMap();
-  
-  // Инициализация GPIO
-  pinMode(PIN_PLUS, OUTPUT);
-  pinMode(PIN_MINUS, OUTPUT);
-  pinMode(PIN_ENTER, OUTPUT);
-  
-  // Устанавливаем LOW по умолчанию
-  digitalWrite(PIN_PLUS, LOW);
-  digitalWrite(PIN_MINUS, LOW);
-  digitalWrite(PIN_ENTER, LOW);
-  
-  // Инициализация камеры
+// ====================== КАМЕРА ======================
+// Драйвер камеры трогают только setup() и задача камеры (команды /jobs):
+// поэтому захват, переинициализация и проверочные кадры окна идут без
+// VisionLock, а мьютекс берётся только на смену состояния распознавания
+
+// Только драйвер, без состояния распознавания
+bool startCamera(pixformat_t fmt) {
   camera_config_t config;
   config.ledc_channel = LEDC_CHANNEL_0;
   config.ledc_timer = LEDC_TIMER_0;
@@ -1217,7 +2970,7 @@ void setup() {
   config.pin_href = 23; config.pin_sccb_sda = 26; config.pin_sccb_scl = 27;
   config.pin_pwdn = 32; config.pin_reset = -1;
   config.xclk_freq_hz = 16000000;
-  config.pixel_format = PIXFORMAT;
+  config.pixel_format = fmt;
   config.frame_size = FRAME_SIZE;
   config.jpeg_quality = 0;
   config.fb_count = 1;
@@ -1226,12 +2979,187 @@ void setup() {
   esp_err_t err = esp_camera_init(&config);
   if (err != ESP_OK) {
     DEBUG_PRINTF("Camera init failed: 0x%x\n", err);
-    return;
+    return false;
   }
-  
+
   sensor_t *s = esp_camera_sensor_get();
   s->set_vflip(s, 1); // Коррекция ориентации
+  return true;
+}
+
+// Запуск камеры и состояние распознавания под формат. Без VisionLock
+bool initCamera(pixformat_t fmt) {
+  if (!startCamera(fmt)) return false;
+  {
+    VisionLock lock;
+    cameraReady = true;
+    exposureBegin();
+    capturePixFormat = fmt;
+    resetDecodeHistory();
+    if (!sensorWindowEnabled) compileSamplingPlan();
+  }
+  if (sensorWindowEnabled) applySensorWindow();
+  return true;
+}
+
+// Переключение формата захвата на лету: буферы камеры зависят от формата,
+// поэтому драйвер переинициализируется целиком. Задача камеры, без VisionLock
+bool setCaptureFormat(pixformat_t fmt) {
+  pixformat_t prev;
+  {
+    VisionLock lock;
+    prev = capturePixFormat;
+    if (fmt == prev) return true;
+    cameraReady = false;
+  }
+  esp_camera_deinit();
+  if (initCamera(fmt)) return true;
+  DEBUG_PRINTLN("⚠️  Capture format switch failed, restoring previous");
+  initCamera(prev);
+  return false;
+}
+
+// Окно сенсора задаётся в режиме SVGA (800x600) - в 5 раз крупнее QQVGA
+const int SENSOR_WINDOW_MODE = 1;   // OV2640: 0 - UXGA, 1 - SVGA, 2 - CIF
+const int SENSOR_WINDOW_W    = 800;
+
+// Окно в координатах FRAME_SIZE вокруг панели (ROI вместе со всей
+// разметкой). false - панель вне кадра. Под VisionLock
+bool panelWindow(Rect &out) {
+  int refW = resolution[FRAME_SIZE].width;
+  int refH = resolution[FRAME_SIZE].height;
+  Rect win = layoutBounds(Rect{ 0, 0, ROI_W, ROI_H });
+  for (int i = 0; i < layout.rectCount(); i++) win = rectUnion(win, layoutBounds(layout.rects()[i]));
+  win = rectIntersect(win, Rect{0, 0, refW, refH});
+  if (win.w <= 0 || win.h <= 0) return false;
+
+  // Выход - ровно FRAME_SIZE: драйвер берёт width/height кадра и длину
+  // DMA-буфера из framesize, кадр другого размера он отбросит. Поэтому окно
+  // расширяется до пропорций кадра 4:3 вокруг панели (масштаб по осям
+  // одинаковый) со сторонами, кратными 16x12: тогда и окно в пикселях
+  // сенсора кратно 4. Не меньше refW/k x refH/k - DSP умеет только уменьшать
+  int k = SENSOR_WINDOW_W / refW;
+  int n = (win.w + 15) / 16;
+  if ((win.h + 11) / 12 > n) n = (win.h + 11) / 12;
+  if (n < (refW / k + 15) / 16) n = (refW / k + 15) / 16;
+  int winW = n * 16, winH = n * 12;
+  if (winW > refW || winH > refH) { winW = refW; winH = refH; }
+  int winX = win.x + win.w / 2 - winW / 2;
+  int winY = win.y + win.h / 2 - winH / 2;
+  winX = winX < 0 ? 0 : (winX > refW - winW ? refW - winW : winX);
+  winY = winY < 0 ? 0 : (winY > refH - winH ? refH - winH : winY);
+  out = Rect{ winX, winY, winW, winH };
+  return true;
+}
+
+// Программирует окно на сенсоре и проверяет по кадру, что драйвер отдаёт
+// полный кадр ожидаемого размера. Снимает два кадра - без VisionLock
+bool programSensorWindow(sensor_t *s, const Rect &win, pixformat_t fmt) {
+  int refW = resolution[FRAME_SIZE].width;
+  int refH = resolution[FRAME_SIZE].height;
+  int k = SENSOR_WINDOW_W / refW;
+  // Смещение окна - в ориентации буфера (строки снизу вверх)
+  int offX = win.x * k;
+  int offY = (refH - (win.y + win.h)) * k;
+  if (s->set_res_raw(s, SENSOR_WINDOW_MODE, 0, 0, 0, offX, offY,
+                     win.w * k, win.h * k, refW, refH, false, false) != 0) {
+    DEBUG_PRINTLN("⚠️  Sensor window setup failed");
+    return false;
+  }
+
+  // Кадр, начатый до смены окна, выбрасываем, а проверяем следующий
+  camera_fb_t *fb = esp_camera_fb_get();
+  if (fb) esp_camera_fb_return(fb);
+  fb = esp_camera_fb_get();
+  size_t expected = (size_t)refW * refH * lumaBytesPerPixel(lumaFormatOf(fmt));
+  bool sizeOk = fb && (int)fb->width == refW && (int)fb->height == refH && fb->len == expected;
+  if (fb) {
+    DEBUG_PRINTF("Sensor window frame: %ux%u, %u bytes (expected %dx%d, %u)\n",
+                 (unsigned)fb->width, (unsigned)fb->height, (unsigned)fb->len, refW, refH, (unsigned)expected);
+    esp_camera_fb_return(fb);
+  }
+  if (!sizeOk) DEBUG_PRINTLN("⚠️  Sensor window: unexpected frame, back to full frame");
+  return sizeOk;
+}
+
+// Ставит окно сенсора по sensorWindowEnabled: только панель или полный
+// кадр. Не вышло - полный кадр и sensorWindowEnabled = false. Только из
+// setup() и задачи камеры, без VisionLock: мьютекс берётся на чтение
+// разметки и на смену frameMap, а сенсор программируется без него
+bool applySensorWindow() {
+  sensor_t *s = esp_camera_sensor_get();
+  if (!s) return false;
+  Rect win;
+  bool want, found = false;
+  pixformat_t fmt;
+  {
+    VisionLock lock;
+    want = sensorWindowEnabled;
+    if (want) found = panelWindow(win);
+    fmt = capturePixFormat;
+  }
+  if (want && s->id.PID != OV2640_PID) {
+    DEBUG_PRINTLN("⚠️  Sensor window is supported on OV2640 only");
+    found = false;
+  }
+
+  bool ok = found && programSensorWindow(s, win, fmt);
+  if (!ok) s->set_framesize(s, FRAME_SIZE);
+
+  VisionLock lock;
+  if (ok) {
+    int refW = resolution[FRAME_SIZE].width;
+    int refH = resolution[FRAME_SIZE].height;
+    frameMap.window = win;
+    frameMap.outW = refW;
+    frameMap.outH = refH;
+    DEBUG_PRINTF("Sensor window %d,%d %dx%d -> %dx%d\n", win.x, win.y, win.w, win.h, refW, refH);
+  } else {
+    frameMap = FrameMapping();
+    sensorWindowEnabled = false;
+  }
+  compileSamplingPlan();
+  return ok || !want;
+}
+
+// Вызывается после любого изменения ROI или разметки. Под VisionLock;
+// окно сенсора под новую разметку ставит задача камеры
+void onGeometryChanged() {
+  // Ручная правка: эталон панели снимается заново
+  driftTracker.clear();
+  driftX = driftY = 0;
+  resetDecodeHistory();
+  compileSamplingPlan();
+  if (sensorWindowEnabled) queueWindowRefresh();
+}
+
+// ====================== SETUP ======================
+void setup() {
+  Serial.begin(115200);
+  DEBUG_PRINTLN("\n\nESP32-CAM Starting...");
+  
+  initMaskMap();
+  initLumaTables();
+  initDefaultLayout();
+  visionMutex = xSemaphoreCreateMutex();
+  resultMutex = xSemaphoreCreateMutex();
+  jobsMutex = xSemaphoreCreateMutex();
   
+  // Инициализация GPIO
+  pinMode(PIN_PLUS, OUTPUT);
+  pinMode(PIN_MINUS, OUTPUT);
+  pinMode(PIN_ENTER, OUTPUT);
+  
+  // Устанавливаем LOW по умолчанию
+  digitalWrite(PIN_PLUS, LOW);
+  digitalWrite(PIN_MINUS, LOW);
+  digitalWrite(PIN_ENTER, LOW);
+  
+  // Инициализация камеры
+  if (!initCamera(capturePixFormat)) {
+    return;
+  }
+
   // Подключение к WiFi
   WiFi.begin(WIFI_SSID, WIFI_PASS);
   DEBUG_PRINT("Connecting to WiFi");
@@ -1255,19 +3183,39 @@ void setup() {
   // Регистрация обработчиков
   server.on("/", handleRoot);
   server.on("/stream", handleStream);        // Отдельная страница потока
-  server.on("/frame", handleFrame);          // Изображение с разметкой
+  server.on("/frame", handleFrame);          // Изображение с разметкой (roi, x/y/w/h, scale, overlay)
+  server.on("/geometry", handleGeometry);    // Разметка в координатах кадра для браузера
+  server.on("/overlay.js", handleOverlayJs); // Общий скрипт разметки для / и /stream
+  server.on("/mjpeg", handleMjpeg);          // Перенаправление на поток MJPEG (порт 81)
+  server.on("/streaming", handleGetStreaming);    // Частота, качество, зрители
+  server.on("/setstreaming", handleSetStreaming); // fps=1..25, quality=20..100, overlay=0|1
   server.on("/control", handleControl);      // Управление пинами
   server.on("/pinstatus", handlePinStatus);  // Статус пинов
   server.on("/roi", handleGetROI);           // Получить текущие ROI
   server.on("/setroi", handleSetROI);        // Установить ROI (x,y,w,h)
-  server.on("/getlayout", handleGetLayout);  // Получить таблицу segPos/topLEDs
-  server.on("/setlayout", HTTP_POST, handleSetLayout); // Установить новую таблицу
+  server.on("/getlayout", handleGetLayout);  // Профили панелей и их разметка
+  server.on("/setlayout", HTTP_POST, handleSetLayout, nullptr, collectBody); // Установить новую таблицу
+  server.on("/calibrate", handleCalibrate);  // Разметка по кадру "88"
   server.on("/thresholds", handleGetThresholds); // Получить пороги
   server.on("/setthresholds", handleSetThresholds); // Установить пороги
   server.on("/setlogging", handleSetLogging);
   server.on("/getlogging", handleGetLogging);
+  server.on("/format", handleGetFormat);       // Текущий формат захвата
+  server.on("/setformat", handleSetFormat);    // Сменить формат (rgb565|gray|yuv)
+  server.on("/setwindow", handleSetWindow);    // Окно сенсора только на панель
+  server.on("/jobs", handleGetJobs);           // Итог /setformat, /setwindow, /calibrate
+  server.on("/settracking", handleSetTracking); // Слежение за сдвигом панели
+  server.on("/homography", handleGetHomography);     // Перспектива разметки
+  server.on("/sethomography", handleSetHomography);  // Углы ROI в кадре или off=1
+  server.on("/sampling", handleGetSampling);   // Расписание и статистика чтений
+  server.on("/setsampling", handleSetSampling); // Бюджет задержки и быстрый период
+  server.on("/exposure", handleGetExposure);   // Состояние регулировки экспозиции
+  server.on("/setexposure", handleSetExposure); // loop=1|0, refreeze=1
+  server.on("/decoder", handleGetDecoder);     // Вшитый или обычный декодер
+  server.on("/setdecoder", handleSetDecoder);  // mode=baked|generic
   // Инициализация OTA обновлений через отдельный AsyncWebServer
   OTAUpdater_begin(otaServer);
+  tileFeedBegin(otaServer);                    // ws://<ip>:8080/tiles - плиточный поток кадра
   otaServer.begin();
 
   // Инициализация DebugLogger: серийный порт + websocket на otaServer:/ws
@@ -1277,12 +3225,10 @@ void setup() {
   DebugLogger::setEnabled(true);
 #endif
 
-  server.begin();
+  startVisionTask();
+  startStreamTask();
 
-  // Register set/get logging handlers (use lambdas capturing nothing)
-  server.on("/setlogging", [](){
-    // Not used - real handler with request is below
-  });
+  server.begin();
 
 
     // Проверка свободной памяти
@@ -1299,9 +3245,46 @@ void setup() {
 
 
 // ====================== LOOP ======================
+// Время между проходами loop(): по нему видно, не задерживает ли его
+// что-нибудь. Среднее и максимум с прошлого чтения /sampling. Пишет loop(),
+// читает и сбрасывает обработчик HTTP в async_tcp - оба под спинлоком,
+// так что сброс не теряется и не делит проход пополам. Сумма - 64 бита:
+// без чтений 32 бит микросекунд хватило бы на 71 минуту
+struct LoopStats {
+  uint32_t last = 0, count = 0, maxUs = 0;
+  uint64_t totalUs = 0;
+  portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+  void step() {
+    uint32_t now = micros();
+    portENTER_CRITICAL(&mux);
+    if (last) {
+      uint32_t d = now - last;
+      totalUs += d;
+      count++;
+      if (d > maxUs) maxUs = d;
+    }
+    last = now;
+    portEXIT_CRITICAL(&mux);
+  }
+
+  // Среднее и максимум с прошлого вызова; счётчики начинаются заново
+  void take(uint32_t &avgUs, uint32_t &maxOut) {
+    portENTER_CRITICAL(&mux);
+    uint64_t total = totalUs;
+    uint32_t n = count;
+    maxOut = maxUs;
+    count = maxUs = 0;
+    totalUs = 0;
+    portEXIT_CRITICAL(&mux);
+    avgUs = n ? (uint32_t)(total / n) : 0;
+  }
+};
+LoopStats loopStats;
+
 void loop() {
-    // Обработка веб-сервера
-    server.handleClient();
+    loopStats.step();
+    tileFeedStep();
     
     // Управление MQTT соединением
     static unsigned long lastMqttCheck = 0;
@@ -1337,128 +3320,335 @@ void loop() {
         if (millis() - discoveryDelayStart > 3000) {
             publishHomeAssistantDiscovery();
             discoveryDelayStart = 0; // Сброс для следующего цикла
+            forceDecode = true;      // значения, прочитанные без связи, ещё не отправлены
         }
     }
     
-    // Чтение данных с камеры и публикация
-    static unsigned long lastCameraRead = 0;
-    if (millis() - lastCameraRead > 2000) { // Каждые 2 секунды
-        if (mqttClient.connected() && discoveryPublished) {
-            String result = readDisplay();
+    // Результаты распознавания от задачи камеры
+    DisplayReading reading;
+    while (readingQueue && xQueueReceive(readingQueue, &reading, 0) == pdTRUE) {
+        String result = formatReading(reading);
+        if (reading.status == READ_OK) {
+            ResultLock lock;
+            lastResult = result;
+        }
+
+        // Чтения идут часто - в лог только изменения
+        static String lastLogged = "";
+        if (result != lastLogged) {
             DEBUG_PRINT("📸 Camera read: ");
-            DEBUG_PRINTLN(result);
-            
-            // Парсим и публикуем данные
+            DEBUG_PRINT(result);
+            DEBUG_PRINT(" (");
+            DEBUG_PRINT(reading.decodeUs);
+            DEBUG_PRINT(" us");
+            DEBUG_PRINTLN(reading.stable ? ")" : ", voting)");
+            lastLogged = result;
+        }
+
+        // Публикуем, только когда последний кадр согласен с голосованием
+        // по окну; неуверенные цифры уже заменены на '?' и не публикуются
+        if (reading.stable && mqttClient.connected() && discoveryPublished) {
             publishMeterData(result);
+            publishLedModes(reading);
         }
-        lastCameraRead = millis();
     }
 }
 
-// Возвращает текущую таблицу segPos и topLEDs в JSON
-void handleGetLayout() {
-  JsonDocument doc;
-  JsonArray segs = doc["segPos"].to<JsonArray>();
-  for (int d = 0; d < DIGITS; d++) {
-    JsonArray segArr = segs.add<JsonArray>();
-    for (int s = 0; s < SEGMENTS; s++) {
-      JsonObject o = segArr.add<JsonObject>();
-      o["x"] = segPos[d][s].x;
-      o["y"] = segPos[d][s].y;
-      o["w"] = segPos[d][s].w;
-      o["h"] = segPos[d][s].h;
-    }
+// Прямоугольник разметки <-> JSON {"x","y","w","h"}
+void rectToJson(JsonArray arr, const Rect &r) {
+  JsonObject o = arr.add<JsonObject>();
+  o["x"] = r.x;
+  o["y"] = r.y;
+  o["w"] = r.w;
+  o["h"] = r.h;
+}
+
+void rectFromJson(JsonObject o, Rect &r) {
+  if (o["x"].is<int>()) r.x = o["x"].as<int>();
+  if (o["y"].is<int>()) r.y = o["y"].as<int>();
+  if (o["w"].is<int>()) r.w = o["w"].as<int>();
+  if (o["h"].is<int>()) r.h = o["h"].as<int>();
+}
+
+// Профили панелей и разметка в JSON - тот же формат принимает /setlayout:
+//   panels  - [{"name","digits","leds","dp"}], по порядку
+//   segPos  - по 7 сегментов на каждую цифру, сквозная нумерация по панелям
+//   dpPos   - точки цифр тех панелей, где dp = true, в том же порядке
+//   topLEDs - светодиоды всех панелей подряд
+void layoutToJson(JsonDocument &doc, const DisplayLayout &l) {
+  JsonArray panels = doc["panels"].to<JsonArray>();
+  for (int p = 0; p < l.panelCount(); p++) {
+    JsonObject o = panels.add<JsonObject>();
+    o["name"] = l.panel(p).name;
+    o["digits"] = l.panel(p).digits;
+    o["leds"] = l.panel(p).leds;
+    o["dp"] = l.panel(p).decimalPoints;
+  }
+
+  JsonArray segArrs = doc["segPos"].to<JsonArray>();
+  JsonArray points = doc["dpPos"].to<JsonArray>();
+  for (int d = 0; d < l.digitCount(); d++) {
+    JsonArray segArr = segArrs.add<JsonArray>();
+    for (int s = 0; s < SEGMENTS; s++) rectToJson(segArr, l.segment(d, s));
+    if (l.pointIndex(d) >= 0) rectToJson(points, l.digitRects()[l.pointIndex(d)]);
   }
 
   JsonArray leds = doc["topLEDs"].to<JsonArray>();
-  int ledCount = sizeof(topLEDs) / sizeof(topLEDs[0]);
-  for (int i = 0; i < ledCount; i++) {
-    JsonObject o = leds.add<JsonObject>();
-    o["x"] = topLEDs[i].x;
-    o["y"] = topLEDs[i].y;
-    o["w"] = topLEDs[i].w;
-    o["h"] = topLEDs[i].h;
+  for (int i = 0; i < l.ledCount(); i++) rectToJson(leds, l.led(i));
+}
+
+void handleGetLayout(AsyncWebServerRequest *request) {
+  JsonDocument doc;
+  {
+    VisionLock lock;
+    layoutToJson(doc, layout);
   }
 
   String out;
   serializeJson(doc, out);
-  server.send(200, "application/json", out);
+  request->send(200, "application/json", out);
+}
+
+// Тело POST целиком в request->_tempObject, его освобождает сам запрос
+const size_t MAX_BODY_BYTES = 16384;
+
+void collectBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
+  if (index == 0) {
+    free(request->_tempObject);
+    request->_tempObject = total <= MAX_BODY_BYTES ? calloc(total + 1, 1) : nullptr;
+  }
+  if (request->_tempObject && index + len <= total) {
+    memcpy((uint8_t*)request->_tempObject + index, data, len);
+  }
 }
 
-// Устанавливает таблицу segPos и topLEDs (ожидает JSON в теле POST)
-void handleSetLayout() {
-  if (!server.hasArg("plain")) {
-    server.send(400, "text/plain", "Missing body");
+void handleSetLayout(AsyncWebServerRequest *request) {
+  VisionLock lock;
+  const char *body = (const char*)request->_tempObject;
+  if (!body) {
+    request->send(400, "text/plain", "Missing or too large body");
     return;
   }
 
-  String body = server.arg("plain");
   JsonDocument doc;
   DeserializationError err = deserializeJson(doc, body);
   if (err) {
-    server.send(400, "text/plain", "Invalid JSON");
+    request->send(400, "text/plain", "Invalid JSON");
     return;
   }
 
-  // Парсим segPos
-  if (doc["segPos"].is<JsonArray>()) {
-    JsonArray segs = doc["segPos"].as<JsonArray>();
-    int dcount = min((size_t)DIGITS, segs.size());
-    for (int d = 0; d < dcount; d++) {
-      JsonArray segArr = segs[d].as<JsonArray>();
-      int scount = min((size_t)SEGMENTS, segArr.size());
-      for (int s = 0; s < scount; s++) {
-        JsonObject o = segArr[s].as<JsonObject>();
-        if (o["x"].is<int>()) segPos[d][s].x = o["x"].as<int>();
-        if (o["y"].is<int>()) segPos[d][s].y = o["y"].as<int>();
-        if (o["w"].is<int>()) segPos[d][s].w = o["w"].as<int>();
-        if (o["h"].is<int>()) segPos[d][s].h = o["h"].as<int>();
+  const char *error = applyLayoutJson(doc);
+  if (error) {
+    request->send(400, "text/plain", error);
+    return;
+  }
+  request->send(200, "text/plain", "OK");
+}
+
+// Имя панели идёт в топики MQTT и unique_id Home Assistant
+bool validPanelName(const char *name) {
+  if (!name[0]) return false;
+  for (const char *c = name; *c; c++) {
+    if (!isalnum((unsigned char)*c) && *c != '_' && *c != '-') return false;
+  }
+  return true;
+}
+
+// Применяет профили и разметку из JSON (/setlayout, /calibrate). Под VisionLock.
+// Без "panels" профиль не меняется. Массивы короче профиля правят только
+// первые элементы, длиннее - ошибка. nullptr - применено, иначе текст ошибки;
+// при ошибке ничего не меняется
+const char *applyLayoutJson(JsonDocument &doc) {
+  PanelProfile panels[PROFILE_MAX_PANELS];
+  int count = 0;
+  int digits = 0, leds = 0, points = 0;
+  if (doc["panels"].is<JsonArray>()) {
+    for (JsonObject o : doc["panels"].as<JsonArray>()) {
+      if (count == PROFILE_MAX_PANELS) return "Too many panels";
+      int nd = o["digits"] | 0;
+      int nl = o["leds"] | 0;
+      if (nd < 0 || nd > PROFILE_MAX_DIGITS || nl < 0 || nl > PROFILE_MAX_LEDS) {
+        return "Digit or LED count out of range";
       }
+      PanelProfile &p = panels[count++];
+      memset(&p, 0, sizeof(p));
+      strncpy(p.name, o["name"] | "", sizeof(p.name) - 1);
+      if (!validPanelName(p.name)) return "Panel name must be 1-15 of [A-Za-z0-9_-]";
+      p.digits = (uint8_t)nd;
+      p.leds = (uint8_t)nl;
+      p.decimalPoints = o["dp"] | false;
     }
+    if (count == 0) return "At least one panel is required";
+  } else {
+    count = layout.panelCount();
+    for (int p = 0; p < count; p++) panels[p] = layout.panel(p);
+  }
+  for (int p = 0; p < count; p++) {
+    digits += panels[p].digits;
+    leds += panels[p].leds;
+    if (panels[p].decimalPoints) points += panels[p].digits;
+  }
+  if (digits > PROFILE_MAX_DIGITS) return "Too many digits in total";
+  if (leds > PROFILE_MAX_LEDS) return "Too many LEDs in total";
+
+  JsonArray segs = doc["segPos"].as<JsonArray>();
+  JsonArray dps = doc["dpPos"].as<JsonArray>();
+  JsonArray ledArr = doc["topLEDs"].as<JsonArray>();
+  if (segs.size() > (size_t)digits) return "segPos has more digits than the profile";
+  if (dps.size() > (size_t)points) return "dpPos has more points than the profile";
+  if (ledArr.size() > (size_t)leds) return "topLEDs has more LEDs than the profile";
+
+  // Профиль изменился - новая арена и история под новые размеры
+  bool profileChanged = count != layout.panelCount();
+  for (int p = 0; p < count && !profileChanged; p++) {
+    const PanelProfile &cur = layout.panel(p);
+    profileChanged = strcmp(cur.name, panels[p].name) != 0 || cur.digits != panels[p].digits ||
+                     cur.leds != panels[p].leds || cur.decimalPoints != panels[p].decimalPoints;
+  }
+  if (profileChanged) {
+    if (!layout.configure(panels, count)) return "Out of memory";
+    resizeDecodeState();
+    discoveryPublished = false;  // сенсоры Home Assistant - по новому профилю
+    DEBUG_PRINTF("Layout: %d panels, %d digits, %d points, %d LEDs\n",
+                 layout.panelCount(), layout.digitCount(), layout.pointCount(), layout.ledCount());
+  }
+
+  for (size_t d = 0; d < segs.size(); d++) {
+    JsonArray segArr = segs[d].as<JsonArray>();
+    size_t scount = min((size_t)SEGMENTS, segArr.size());
+    for (size_t s = 0; s < scount; s++) rectFromJson(segArr[s].as<JsonObject>(), layout.segment(d, s));
+  }
+  // Точки нумеруются по порядку цифр, у которых они есть
+  size_t pt = 0;
+  for (int d = 0; d < layout.digitCount() && pt < dps.size(); d++) {
+    if (layout.pointIndex(d) < 0) continue;
+    rectFromJson(dps[pt++].as<JsonObject>(), layout.rects()[layout.pointIndex(d)]);
+  }
+  for (size_t i = 0; i < ledArr.size(); i++) rectFromJson(ledArr[i].as<JsonObject>(), layout.led(i));
+
+  onGeometryChanged();
+  return nullptr;
+}
+
+// Калибровка по свежему кадру: на индикаторе все цифры "8", все
+// светодиоды горят. Разметка ищется по кадру внутри ROI и применяется как
+// через /setlayout (профиль прежний, точки не трогаются); dry - только
+// итог. Задача камеры, без VisionLock: поиск идёт по кадру из кэша без
+// мьютекса, под ним - только чтение ROI и применение разметки
+bool runCalibration(bool dry, String &result) {
+  FrameRef frame = captureFrame() ? FrameBroker::latest() : FrameRef();
+  if (!frame) {
+    result = "Camera error";
+    return false;
+  }
+
+  Rect roi;
+  int digits, leds;
+  {
+    VisionLock lock;
+    // Поиск идёт в координатах кадра, а разметка хранится в координатах ROI
+    // полного кадра без перспективы - только тогда они совпадают
+    if (frameMap.active() || homographyEnabled) {
+      result = "Disable sensor window and perspective first";
+      return false;
+    }
+    roi = Rect{ ROI_X, ROI_Y, ROI_W, ROI_H };
+    digits = layout.digitCount();
+    leds = layout.ledCount();
+  }
+  if (digits < 1 || digits > CAL_MAX_DIGITS || leds > CAL_MAX_LEDS) {
+    result = "Profile needs 1.." + String(CAL_MAX_DIGITS) + " digits and up to " +
+             String(CAL_MAX_LEDS) + " LEDs for calibration";
+    return false;
+  }
+
+  LayoutProposal proposal;
+  unsigned long t0 = micros();
+  CalibrationStatus st = calibrateLayout(frame.buf(), frame.width(), frame.height(),
+                                         lumaFormatOf(frame.format()), roi, digits, leds, proposal);
+  unsigned long us = micros() - t0;
+  frame.release();
+  DEBUG_PRINTF("Calibration: %s (threshold %d, %lu us)\n", calibrationStatusName(st),
+               proposal.threshold, us);
+  if (st != CAL_OK) {
+    result = calibrationStatusName(st);
+    return false;
   }
 
-  // Парсим topLEDs
-  if (doc["topLEDs"].is<JsonArray>()) {
-    JsonArray leds = doc["topLEDs"].as<JsonArray>();
-    int ledCount = min((size_t)(sizeof(topLEDs)/sizeof(topLEDs[0])), leds.size());
-    for (int i = 0; i < ledCount; i++) {
-      JsonObject o = leds[i].as<JsonObject>();
-      if (o["x"].is<int>()) topLEDs[i].x = o["x"].as<int>();
-      if (o["y"].is<int>()) topLEDs[i].y = o["y"].as<int>();
-      if (o["w"].is<int>()) topLEDs[i].w = o["w"].as<int>();
-      if (o["h"].is<int>()) topLEDs[i].h = o["h"].as<int>();
+  JsonDocument doc;
+  JsonArray segArrs = doc["segPos"].to<JsonArray>();
+  for (int d = 0; d < digits; d++) {
+    JsonArray segArr = segArrs.add<JsonArray>();
+    for (int s = 0; s < SEGMENTS; s++) rectToJson(segArr, proposal.segments[d][s]);
+  }
+  JsonArray ledArr = doc["topLEDs"].to<JsonArray>();
+  for (int i = 0; i < leds; i++) rectToJson(ledArr, proposal.leds[i]);
+
+  if (!dry) {
+    VisionLock lock;
+    // Пока шёл поиск, ROI или профиль могли поменять через HTTP
+    if (ROI_X != roi.x || ROI_Y != roi.y || ROI_W != roi.w || ROI_H != roi.h ||
+        layout.digitCount() != digits || layout.ledCount() != leds) {
+      result = "Layout changed during calibration";
+      return false;
+    }
+    const char *error = applyLayoutJson(doc);
+    if (error) {
+      result = error;
+      return false;
     }
   }
+  doc["applied"] = !dry;
+  doc["threshold"] = proposal.threshold;
+  doc["us"] = us;
+  serializeJson(doc, result);
+  return true;
+}
 
-  server.send(200, "text/plain", "OK");
+// /calibrate[?dry=1]: калибровку выполняет задача камеры, итог - в /jobs
+void handleCalibrate(AsyncWebServerRequest *request) {
+  bool dry = request->hasArg("dry") && request->arg("dry").toInt() == 1;
+  sendJobQueued(request, JOB_CALIBRATE, queueJob(JOB_CALIBRATE, dry ? 1 : 0));
 }
 
 // Возвращает текущие пороги в JSON
-void handleGetThresholds() {
+void handleGetThresholds(AsyncWebServerRequest *request) {
   String json = "{";
   json += "\"seg\":" + String(threshSegment) + ",";
-  json += "\"led\":" + String(threshLED);
+  json += "\"led\":" + String(threshLED) + ",";
+  json += "\"auto\":" + String(autoThresholds ? "true" : "false") + ",";
+  json += "\"seg_eff\":" + String(effThreshSegment) + ",";
+  json += "\"led_eff\":" + String(effThreshLED);
   json += "}";
-  server.send(200, "application/json", json);
+  request->send(200, "application/json", json);
 }
 
-// Устанавливает пороги через query-параметры seg и led
-void handleSetThresholds() {
+// Устанавливает пороги через query-параметры seg и led, auto=1|0 - автопорог
+void handleSetThresholds(AsyncWebServerRequest *request) {
+  VisionLock lock;
   bool changed = false;
-  if (server.hasArg("seg")) {
-    int v = server.arg("seg").toInt(); if (v >= 0) { threshSegment = v; changed = true; }
+  if (request->hasArg("seg")) {
+    int v = request->arg("seg").toInt(); if (v >= 0) { threshSegment = v; changed = true; }
   }
-  if (server.hasArg("led")) {
-    int v = server.arg("led").toInt(); if (v >= 0) { threshLED = v; changed = true; }
+  if (request->hasArg("led")) {
+    int v = request->arg("led").toInt(); if (v >= 0) { threshLED = v; changed = true; }
+  }
+  if (request->hasArg("auto")) {
+    autoThresholds = request->arg("auto").toInt() == 1; changed = true;
   }
 
-  if (changed) server.send(200, "text/plain", "OK"); else server.send(400, "text/plain", "Missing or invalid parameters");
+  if (changed) {
+    resetDecodeHistory();  // история посчитана со старыми порогами
+    request->send(200, "text/plain", "OK");
+  } else {
+    request->send(400, "text/plain", "Missing or invalid parameters");
+  }
 }
 
 // Устанавливает состояние логирования по query ?en=1|0|toggle
-void handleSetLogging() {
-  if (!server.hasArg("en")) { server.send(400, "application/json", "{\"error\":\"missing en\"}"); return; }
-  String v = server.arg("en");
+void handleSetLogging(AsyncWebServerRequest *request) {
+  if (!request->hasArg("en")) { request->send(400, "application/json", "{\"error\":\"missing en\"}"); return; }
+  String v = request->arg("en");
   if (v == "toggle") {
     DebugLogger::setEnabled(!DebugLogger::isEnabled());
   } else if (v == "1") {
@@ -1469,12 +3659,284 @@ void handleSetLogging() {
   String json = "{";
   json += "\"enabled\":" + String(DebugLogger::isEnabled() ? 1 : 0);
   json += "}";
-  server.send(200, "application/json", json);
+  request->send(200, "application/json", json);
 }
 
-void handleGetLogging() {
+void handleGetLogging(AsyncWebServerRequest *request) {
   String json = "{";
   json += "\"enabled\":" + String(DebugLogger::isEnabled() ? 1 : 0);
   json += "}";
-  server.send(200, "application/json", json);
-}
\ No newline at end of file
+  request->send(200, "application/json", json);
+}
+const char *pixFormatName(pixformat_t f) {
+  if (f == PIXFORMAT_GRAYSCALE) return "gray";
+  if (f == PIXFORMAT_YUV422) return "yuv";
+  return "rgb565";
+}
+
+// Возвращает текущий формат захвата
+void handleGetFormat(AsyncWebServerRequest *request) {
+  String json = "{";
+  json += "\"fmt\":\"" + String(pixFormatName(capturePixFormat)) + "\"";
+  json += "}";
+  request->send(200, "application/json", json);
+}
+
+// Меняет формат захвата через query ?fmt=rgb565|gray|yuv
+void handleSetFormat(AsyncWebServerRequest *request) {
+  if (!request->hasArg("fmt")) { request->send(400, "text/plain", "Missing fmt"); return; }
+  String v = request->arg("fmt");
+  pixformat_t fmt;
+  if (v == "rgb565") fmt = PIXFORMAT_RGB565;
+  else if (v == "gray") fmt = PIXFORMAT_GRAYSCALE;
+  else if (v == "yuv") fmt = PIXFORMAT_YUV422;
+  else { request->send(400, "text/plain", "Unknown fmt"); return; }
+
+  // Переинициализацию выполняет задача камеры, итог - в /jobs
+  sendJobQueued(request, JOB_FORMAT, queueJob(JOB_FORMAT, fmt));
+}
+
+// Включает/выключает окно сенсора по query ?en=1|0; ставит его задача
+// камеры, итог - в /jobs
+void handleSetWindow(AsyncWebServerRequest *request) {
+  if (!request->hasArg("en")) { request->send(400, "text/plain", "Missing en"); return; }
+  sendJobQueued(request, JOB_WINDOW, queueJob(JOB_WINDOW, request->arg("en").toInt() == 1 ? 1 : 0));
+}
+
+// Команды задаче камеры: номер, состояние и итог последней команды
+// каждого вида. Ответ /setformat, /setwindow, /calibrate - {"job", "id"}:
+// команда выполнена, когда jobs[job].id == id и state - done или failed
+void handleGetJobs(AsyncWebServerRequest *request) {
+  JsonDocument doc;
+  {
+    JobsLock lock;
+    for (int k = 0; k < JOB_COUNT; k++) {
+      JsonObject o = doc[JOB_NAMES[k]].to<JsonObject>();
+      o["id"] = jobs[k].id;
+      o["state"] = JOB_STATE_NAMES[jobs[k].state];
+      if (jobs[k].state == JOB_FAILED) o["error"] = jobs[k].result;
+      else if (jobs[k].state == JOB_DONE && jobs[k].result.length()) o["result"] = serialized(jobs[k].result);
+    }
+  }
+
+  String out;
+  serializeJson(doc, out);
+  request->send(200, "application/json", out);
+}
+
+// Расписание чтений и статистика в JSON
+void handleGetSampling(AsyncWebServerRequest *request) {
+  SampleScheduler::Stats st;
+  uint32_t fast, budget, burst, period;
+  uint32_t loopAvgUs, loopMaxUs;
+  loopStats.take(loopAvgUs, loopMaxUs);
+  {
+    VisionLock lock;
+    st = sampleScheduler.stats();
+    fast = sampleScheduler.fastMs();
+    budget = sampleScheduler.budgetMs();
+    burst = sampleScheduler.burstMs();
+    period = sampleScheduler.period();
+  }
+  String json = "{";
+  json += "\"fast_ms\":" + String(fast) + ",";
+  json += "\"budget_ms\":" + String(budget) + ",";
+  json += "\"burst_ms\":" + String(burst) + ",";
+  json += "\"period_ms\":" + String(period) + ",";
+  json += "\"samples\":" + String(st.samples) + ",";
+  json += "\"active\":" + String(st.activeSamples) + ",";
+  json += "\"boosts\":" + String(st.boosts) + ",";
+  json += "\"decoded\":" + String(framesDecoded) + ",";
+  json += "\"unchanged\":" + String(framesUnchanged) + ",";
+  json += "\"avg_interval_ms\":" + String(st.avgIntervalMs) + ",";
+  json += "\"max_interval_ms\":" + String(st.maxIntervalMs) + ",";
+  json += "\"over_budget\":" + String(st.overBudget) + ",";
+  json += "\"loop_avg_us\":" + String(loopAvgUs) + ",";
+  json += "\"loop_max_us\":" + String(loopMaxUs);
+  json += "}";
+  request->send(200, "application/json", json);
+}
+
+// /setsampling?budget=2000&fast=100&burst=3000&reset=1
+void handleSetSampling(AsyncWebServerRequest *request) {
+  VisionLock lock;
+  uint32_t fast = sampleScheduler.fastMs();
+  uint32_t budget = sampleScheduler.budgetMs();
+  uint32_t burst = sampleScheduler.burstMs();
+  bool changed = false;
+  if (request->hasArg("fast")) {
+    int v = request->arg("fast").toInt(); if (v >= 10) { fast = v; changed = true; }
+  }
+  if (request->hasArg("budget")) {
+    int v = request->arg("budget").toInt(); if (v >= 10) { budget = v; changed = true; }
+  }
+  if (request->hasArg("burst")) {
+    int v = request->arg("burst").toInt(); if (v >= 0) { burst = v; changed = true; }
+  }
+  if (request->hasArg("reset")) {
+    sampleScheduler.resetStats();
+    changed = true;
+  }
+
+  if (changed) {
+    sampleScheduler.configure(fast, budget, burst);
+    request->send(200, "text/plain", "OK");
+  } else {
+    request->send(400, "text/plain", "Missing or invalid parameters");
+  }
+}
+
+// /settracking?en=1|0 - слежение за сдвигом; ref=1 - снять эталон заново
+void handleSetTracking(AsyncWebServerRequest *request) {
+  VisionLock lock;
+  bool changed = false;
+  if (request->hasArg("en")) {
+    driftTracking = request->arg("en").toInt() == 1;
+    changed = true;
+  }
+  if (request->hasArg("ref") && request->arg("ref").toInt() == 1) {
+    changed = true;
+  }
+  if (changed) {
+    // Включение или явный запрос - эталон с ближайшего кадра
+    driftTracker.clear();
+    driftX = driftY = 0;
+    request->send(200, "text/plain", "OK");
+  } else {
+    request->send(400, "text/plain", "Missing or invalid parameters");
+  }
+}
+
+// Текущая перспектива разметки в JSON
+void handleGetHomography(AsyncWebServerRequest *request) {
+  VisionLock lock;
+  String json = "{";
+  json += "\"enabled\":" + String(homographyEnabled ? "true" : "false") + ",";
+  json += "\"m\":[";
+  for (int i = 0; i < 9; i++) {
+    if (i) json += ",";
+    json += String(layoutWarp.m[i], 6);
+  }
+  json += "]}";
+  request->send(200, "application/json", json);
+}
+
+// /sethomography?pts=x0,y0,x1,y1,x2,y2,x3,y3 - где в кадре видны углы ROI
+// (левый верхний, правый верхний, правый нижний, левый нижний);
+// /sethomography?off=1 - снова прямоугольная разметка
+void handleSetHomography(AsyncWebServerRequest *request) {
+  VisionLock lock;
+  if (request->hasArg("off") && request->arg("off").toInt() == 1) {
+    homographyEnabled = false;
+    layoutWarp = Homography();
+    onGeometryChanged();
+    request->send(200, "text/plain", "OK");
+    return;
+  }
+  if (!request->hasArg("pts")) {
+    request->send(400, "text/plain", "Missing pts");
+    return;
+  }
+
+  String pts = request->arg("pts");
+  float dst[8];
+  int n = 0, start = 0;
+  while (n < 8 && start <= (int)pts.length()) {
+    int comma = pts.indexOf(',', start);
+    if (comma < 0) comma = pts.length();
+    dst[n++] = pts.substring(start, comma).toFloat();
+    start = comma + 1;
+  }
+  if (n != 8) {
+    request->send(400, "text/plain", "Expected 8 numbers");
+    return;
+  }
+
+  // Углы задаются в координатах кадра, а преобразование - относительно ROI
+  for (int i = 0; i < 4; i++) {
+    dst[2*i] -= ROI_X;
+    dst[2*i + 1] -= ROI_Y;
+  }
+  float src[8] = { 0, 0, (float)ROI_W, 0, (float)ROI_W, (float)ROI_H, 0, (float)ROI_H };
+  Homography h;
+  if (!h.fromPoints(src, dst)) {
+    request->send(400, "text/plain", "Degenerate corners");
+    return;
+  }
+  layoutWarp = h;
+  homographyEnabled = true;
+  onGeometryChanged();
+  request->send(200, "text/plain", "OK");
+}
+
+// Состояние регулировки экспозиции в JSON
+void handleGetExposure(AsyncWebServerRequest *request) {
+  VisionLock lock;
+  String json = "{";
+  json += "\"loop\":" + String(exposureLoop ? "true" : "false") + ",";
+  json += "\"frozen\":" + String(exposureCtl.frozen() ? "true" : "false") + ",";
+  json += "\"exposure\":" + String(exposureCtl.exposure()) + ",";
+  json += "\"gain\":" + String(exposureCtl.gain()) + ",";
+  json += "\"bright\":" + String(exposureCtl.bright()) + ",";
+  json += "\"contrast\":" + String(exposureCtl.contrast()) + ",";
+  json += "\"mean\":" + String(exposureCtl.mean()) + ",";
+  json += "\"searching\":" + String(exposureCtl.searching() ? "true" : "false") + ",";
+  json += "\"adjustments\":" + String(exposureCtl.adjustments());
+  json += "}";
+  request->send(200, "application/json", json);
+}
+
+// /setexposure?loop=1|0 - своя регулировка или AEC/AGC сенсора;
+// refreeze=1 - подстроиться заново (например, после смены освещения)
+void handleSetExposure(AsyncWebServerRequest *request) {
+  VisionLock lock;
+  bool changed = false;
+  if (request->hasArg("loop")) {
+    exposureLoop = request->arg("loop").toInt() == 1;
+    exposureBegin();
+    changed = true;
+  }
+  if (request->hasArg("refreeze") && request->arg("refreeze").toInt() == 1) {
+    exposureCtl.unfreeze();
+    changed = true;
+  }
+  if (changed) {
+    request->send(200, "text/plain", "OK");
+  } else {
+    request->send(400, "text/plain", "Missing or invalid parameters");
+  }
+}
+
+// Какой декодер читает цифры и совпадает ли ещё геометрия с вшитой
+void handleGetDecoder(AsyncWebServerRequest *request) {
+  JsonDocument doc;
+  {
+    VisionLock lock;
+    doc["baked_built"] = bakedBuilt;
+    doc["mode"] = bakedDecoder ? "baked" : "generic";
+    doc["baked_valid"] = bakedValid;
+  }
+
+  String out;
+  serializeJson(doc, out);
+  request->send(200, "application/json", out);
+}
+
+// /setdecoder?mode=baked|generic
+void handleSetDecoder(AsyncWebServerRequest *request) {
+  VisionLock lock;
+  String mode = request->arg("mode");
+  if (mode == "generic") {
+    bakedDecoder = false;
+  } else if (mode == "baked") {
+    if (!bakedBuilt) {
+      request->send(409, "text/plain", "Firmware built without BAKED_LAYOUT");
+      return;
+    }
+    bakedDecoder = true;
+  } else {
+    request->send(400, "text/plain", "Missing or invalid parameters");
+    return;
+  }
+  request->send(200, "text/plain", "OK");
+}
@@ -0,0 +1,129 @@
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include "LumaSampler.h"
+#include "baked_layout.h"
+
+// Вшитая выборка против плана выборки на той же разметке: средние должны
+// совпадать бит в бит, иначе переключение baked/generic меняет показания.
+// Время - на ПК, смотреть стоит на соотношение.
+
+static const int COUNT = BakedDigitSampler::COUNT;
+static const int W = BakedDigitSampler::FRAME_W, H = BakedDigitSampler::FRAME_H;
+
+// Буфер кадра выровнен на 4, как у камеры: вшитая выборка читает словами
+alignas(4) static uint8_t frame[W * H * 2];
+static uint32_t rng = 1;
+
+static uint32_t nextRandom() {
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return rng;
+}
+
+static void fillFrame(uint32_t seed) {
+  rng = seed;
+  for (size_t i = 0; i < sizeof(frame); i++) frame[i] = (uint8_t)nextRandom();
+}
+
+// Прямоугольники вшитой разметки в координатах кадра - так их получает план
+template <class Sampler>
+static void absoluteRects(Rect *out) {
+  Sampler::rects(out);
+  for (int i = 0; i < Sampler::COUNT; i++) {
+    out[i].x += Sampler::ROI_X;
+    out[i].y += Sampler::ROI_Y;
+  }
+}
+
+template <class F>
+static double microsPerRun(int runs, F f) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < runs; i++) f();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(t1 - t0).count() / runs;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_baked_layout_matches_plan() {
+  Rect rects[COUNT];
+  absoluteRects<BakedDigitSampler>(rects);
+  SamplingPlan plan;
+  TEST_ASSERT_TRUE(plan.compile(rects, COUNT, W, H, BakedDigitSampler::FORMAT));
+
+  for (uint32_t seed = 1; seed <= 20; seed++) {
+    fillFrame(seed * 2654435761u);
+    int expected[COUNT], actual[COUNT];
+    TEST_ASSERT_TRUE(plan.sample(frame, expected));
+    BakedDigitSampler::sample(frame, actual);
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, actual, COUNT);
+  }
+}
+
+// Чтение по 4 пикселя GRAY8 и нечётные смещения строк - в вшитой разметке
+// по умолчанию их нет, поэтому отдельная разметка
+typedef BakedSampler<160, 120, LUMA_GRAY8, 3, 5,
+  BakedRect<0, 0, 9, 4>, BakedRect<1, 3, 5, 7>, BakedRect<150, 110, 7, 5>, BakedRect<60, 40, 1, 1>
+> GraySampler;
+
+void test_gray8_baked_matches_plan() {
+  const int n = GraySampler::COUNT;
+  Rect rects[n];
+  absoluteRects<GraySampler>(rects);
+  SamplingPlan plan;
+  TEST_ASSERT_TRUE(plan.compile(rects, n, 160, 120, LUMA_GRAY8));
+
+  for (uint32_t seed = 1; seed <= 20; seed++) {
+    fillFrame(seed * 40503u);
+    int expected[n], actual[n];
+    TEST_ASSERT_TRUE(plan.sample(frame, expected));
+    GraySampler::sample(frame, actual);
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, actual, n);
+  }
+}
+
+// matches() узнаёт свою геометрию и отказывает при любой правке
+void test_matches_only_baked_geometry() {
+  Rect layout[COUNT];
+  BakedDigitSampler::rects(layout);
+  const int rx = BakedDigitSampler::ROI_X, ry = BakedDigitSampler::ROI_Y;
+  TEST_ASSERT_TRUE(BakedDigitSampler::matches(W, H, LUMA_RGB565, rx, ry, layout, COUNT));
+  TEST_ASSERT_FALSE(BakedDigitSampler::matches(W, H, LUMA_GRAY8, rx, ry, layout, COUNT));
+  TEST_ASSERT_FALSE(BakedDigitSampler::matches(W, H, LUMA_RGB565, rx + 1, ry, layout, COUNT));
+  TEST_ASSERT_FALSE(BakedDigitSampler::matches(320, 240, LUMA_RGB565, rx, ry, layout, COUNT));
+  TEST_ASSERT_FALSE(BakedDigitSampler::matches(W, H, LUMA_RGB565, rx, ry, layout, COUNT - 1));
+  layout[3].w++;
+  TEST_ASSERT_FALSE(BakedDigitSampler::matches(W, H, LUMA_RGB565, rx, ry, layout, COUNT));
+}
+
+void test_bench_baked_vs_plan() {
+  const int RUNS = 50000;
+  Rect rects[COUNT];
+  absoluteRects<BakedDigitSampler>(rects);
+  SamplingPlan plan;
+  TEST_ASSERT_TRUE(plan.compile(rects, COUNT, W, H, BakedDigitSampler::FORMAT));
+  fillFrame(42);
+
+  int means[COUNT];
+  volatile int sink = 0;
+  double generic = microsPerRun(RUNS, [&] { plan.sample(frame, means); sink += means[0]; });
+  double baked = microsPerRun(RUNS, [&] { BakedDigitSampler::sample(frame, means); sink += means[0]; });
+
+  char msg[160];
+  snprintf(msg, sizeof(msg), "sampling plan %.3f us, baked sampler %.3f us per frame (%d rects, x%.1f)",
+           generic, baked, COUNT, generic / baked);
+  TEST_MESSAGE(msg);
+}
+
+int main(int, char **) {
+  initLumaTables();
+  UNITY_BEGIN();
+  RUN_TEST(test_baked_layout_matches_plan);
+  RUN_TEST(test_gray8_baked_matches_plan);
+  RUN_TEST(test_matches_only_baked_geometry);
+  RUN_TEST(test_bench_baked_vs_plan);
+  return UNITY_END();
+}
@@ -0,0 +1,477 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include "FrameCodec.h"
+
+// QOI и PNG на кадре 160x120: выход разбирается здесь же простыми
+// декодерами (QOI по спецификации, PNG с проверкой CRC, inflate и Adler-32)
+// и сравнивается со входом байт в байт. Размер - против BMP того же кадра,
+// время - на ПК, смотреть стоит на соотношение.
+
+static const int W = 160, H = 120;
+
+typedef std::vector<uint8_t> Bytes;
+
+static size_t toBytes(void *arg, const uint8_t *data, size_t len) {
+  Bytes *out = (Bytes*)arg;
+  out->insert(out->end(), data, data + len);
+  return len;
+}
+
+// Сокет, который принимает не больше limit байт
+struct ShortWriter {
+  size_t limit, written;
+};
+
+static size_t toShortWriter(void *arg, const uint8_t *data, size_t len) {
+  ShortWriter *w = (ShortWriter*)arg;
+  (void)data;
+  size_t n = len < w->limit - w->written ? len : w->limit - w->written;
+  w->written += n;
+  return n;
+}
+
+static uint32_t rng = 1;
+
+static uint32_t nextRandom() {
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return rng;
+}
+
+// Похоже на то, что видит камера: тёмный фон с градиентом и шумом,
+// светлые сегменты и светодиоды; noise = 255 - просто случайные байты.
+// Цветной кадр приходит в RGB565 и расширяется до RGB888, как в /frame
+static void makeFrame(uint8_t *px, int channels, int noise, uint32_t seed) {
+  rng = seed;
+  for (int y = 0; y < H; y++) {
+    for (int x = 0; x < W; x++) {
+      bool lit = (y % 40 > 10 && y % 40 < 14 && x % 30 > 5 && x % 30 < 20) || (y < 6 && x % 32 < 4);
+      int base = lit ? 220 : 30 + x / 8 + y / 6;
+      uint8_t v[3];
+      for (int c = 0; c < 3; c++) {
+        int n = base + (int)(nextRandom() % (2 * noise + 1)) - noise + c * 5;
+        v[c] = (uint8_t)(n < 0 ? 0 : n > 255 ? 255 : n);
+      }
+      if (channels == 1) {
+        px[y * W + x] = v[0];
+        continue;
+      }
+      uint8_t *p = px + (y * W + x) * 3;
+      p[0] = (v[0] >> 3) * 255 / 31;
+      p[1] = (v[1] >> 2) * 255 / 63;
+      p[2] = (v[2] >> 3) * 255 / 31;
+    }
+  }
+}
+
+template <class Encoder>
+static bool encode(const uint8_t *px, int channels, Bytes &out) {
+  out.clear();
+  Encoder enc(toBytes, &out);
+  if (!enc.begin(W, H, channels)) return false;
+  for (int y = 0; y < H; y++) {
+    if (!enc.writeRow(px + y * W * channels)) return false;
+  }
+  return enc.end() && enc.bytes() == out.size();
+}
+
+static uint32_t readBE32(const uint8_t *p) {
+  return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+// ====================== QOI ======================
+// Декодер по спецификации qoiformat.org; выход - RGB
+static bool decodeQoi(const Bytes &in, int &w, int &h, Bytes &rgb) {
+  if (in.size() < 22 || memcmp(in.data(), "qoif", 4) != 0) return false;
+  w = (int)readBE32(&in[4]);
+  h = (int)readBE32(&in[8]);
+  static const uint8_t END[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+  if (memcmp(&in[in.size() - 8], END, 8) != 0) return false;
+
+  uint8_t index[64][4];
+  memset(index, 0, sizeof(index));
+  uint8_t px[4] = { 0, 0, 0, 255 };
+  size_t p = 14, end = in.size() - 8;
+  int run = 0;
+  rgb.clear();
+  for (long i = 0; i < (long)w * h; i++) {
+    if (run > 0) {
+      run--;
+    } else {
+      if (p >= end) return false;
+      uint8_t b = in[p++];
+      if (b == 0xFE) {
+        px[0] = in[p]; px[1] = in[p + 1]; px[2] = in[p + 2];
+        p += 3;
+      } else if (b == 0xFF) {
+        px[0] = in[p]; px[1] = in[p + 1]; px[2] = in[p + 2]; px[3] = in[p + 3];
+        p += 4;
+      } else if ((b & 0xC0) == 0x00) {
+        memcpy(px, index[b], 4);
+      } else if ((b & 0xC0) == 0x40) {
+        px[0] += ((b >> 4) & 3) - 2;
+        px[1] += ((b >> 2) & 3) - 2;
+        px[2] += (b & 3) - 2;
+      } else if ((b & 0xC0) == 0x80) {
+        int dg = (b & 0x3F) - 32;
+        uint8_t b2 = in[p++];
+        px[0] += dg + ((b2 >> 4) & 15) - 8;
+        px[1] += dg;
+        px[2] += dg + (b2 & 15) - 8;
+      } else {
+        run = b & 0x3F;
+      }
+      memcpy(index[(px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) & 63], px, 4);
+    }
+    if (px[3] != 255) return false;
+    rgb.insert(rgb.end(), px, px + 3);
+  }
+  return p == end;
+}
+
+// ====================== PNG ======================
+static uint32_t crc32(const uint8_t *p, size_t len) {
+  uint32_t crc = 0xFFFFFFFF;
+  while (len--) {
+    crc ^= *p++;
+    for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+struct BitReader {
+  const uint8_t *p;
+  size_t len, pos = 0;
+  int bit = 0;
+  bool over = false;
+
+  BitReader(const uint8_t *data, size_t n) : p(data), len(n) {}
+  uint32_t get(int n) {   // младшим битом вперёд
+    uint32_t v = 0;
+    for (int i = 0; i < n; i++) {
+      if (pos >= len) { over = true; return 0; }
+      v |= (uint32_t)((p[pos] >> bit) & 1) << i;
+      if (++bit == 8) { bit = 0; pos++; }
+    }
+    return v;
+  }
+  void align() { if (bit) { bit = 0; pos++; } }
+};
+
+// Канонический код Хаффмана по длинам (RFC 1951, 3.2.2): число кодов
+// каждой длины и символы по возрастанию кода
+struct Huffman {
+  int count[16];
+  int symbol[288];
+
+  bool build(const uint8_t *lengths, int n) {
+    memset(count, 0, sizeof(count));
+    for (int s = 0; s < n; s++) count[lengths[s]]++;
+    int offset[16] = { 0 };
+    for (int len = 1; len < 15; len++) offset[len + 1] = offset[len] + count[len];
+    for (int s = 0; s < n; s++) if (lengths[s]) symbol[offset[lengths[s]]++] = s;
+    long left = 1;   // код не переполнен
+    for (int len = 1; len < 16; len++) {
+      left = left * 2 - count[len];
+      if (left < 0) return false;
+    }
+    return true;
+  }
+
+  int decode(BitReader &in) const {
+    int code = 0, first = 0, index = 0;
+    for (int len = 1; len < 16 && !in.over; len++) {
+      code |= (int)in.get(1);
+      if (code - first < count[len]) return symbol[index + code - first];
+      index += count[len];
+      first = (first + count[len]) << 1;
+      code <<= 1;
+    }
+    return -1;
+  }
+};
+
+// Таблицы динамического блока (RFC 1951, 3.2.7)
+static bool readDynamic(BitReader &in, Huffman &lit, Huffman &dist) {
+  static const uint8_t ORDER[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+  int nlen = (int)in.get(5) + 257, ndist = (int)in.get(5) + 1, ncode = (int)in.get(4) + 4;
+  if (nlen > 286 || ndist > 30) return false;
+  uint8_t lengths[320] = { 0 };
+  for (int i = 0; i < ncode; i++) lengths[ORDER[i]] = (uint8_t)in.get(3);
+  Huffman cl;
+  if (!cl.build(lengths, 19)) return false;
+  memset(lengths, 0, sizeof(lengths));
+  for (int i = 0; i < nlen + ndist;) {
+    int sym = cl.decode(in);
+    if (sym < 0) return false;
+    if (sym < 16) { lengths[i++] = (uint8_t)sym; continue; }
+    int repeat, value = 0;
+    if (sym == 16) {
+      if (i == 0) return false;
+      value = lengths[i - 1];
+      repeat = 3 + (int)in.get(2);
+    } else if (sym == 17) {
+      repeat = 3 + (int)in.get(3);
+    } else {
+      repeat = 11 + (int)in.get(7);
+    }
+    if (i + repeat > nlen + ndist) return false;
+    while (repeat--) lengths[i++] = (uint8_t)value;
+  }
+  return lit.build(lengths, nlen) && dist.build(lengths + nlen, ndist);
+}
+
+// inflate: блоки без сжатия, с фиксированным и с динамическим кодом
+static bool inflate(const uint8_t *data, size_t len, Bytes &out) {
+  static const uint16_t LBASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                      35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+  static const uint8_t LEXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                      3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+  static const uint16_t DBASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                      257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                      8193, 12289, 16385, 24577 };
+  static const uint8_t DEXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                      7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+  BitReader in(data, len);
+  bool last = false;
+  while (!last) {
+    last = in.get(1);
+    int type = (int)in.get(2);
+    if (type == 0) {
+      in.align();
+      if (in.pos + 4 > len) return false;
+      size_t n = data[in.pos] | data[in.pos + 1] << 8;
+      in.pos += 4;
+      if (in.pos + n > len) return false;
+      out.insert(out.end(), data + in.pos, data + in.pos + n);
+      in.pos += n;
+      continue;
+    }
+
+    Huffman lit, dist;
+    if (type == 1) {
+      uint8_t lengths[288 + 30];
+      for (int s = 0; s < 288; s++) lengths[s] = s < 144 ? 8 : s < 256 ? 9 : s < 280 ? 7 : 8;
+      for (int s = 0; s < 30; s++) lengths[288 + s] = 5;
+      lit.build(lengths, 288);
+      dist.build(lengths + 288, 30);
+    } else if (type != 2 || !readDynamic(in, lit, dist)) {
+      return false;
+    }
+    for (;;) {
+      int sym = lit.decode(in);
+      if (sym < 0 || in.over) return false;
+      if (sym < 256) { out.push_back((uint8_t)sym); continue; }
+      if (sym == 256) break;
+      if (sym > 285) return false;
+      size_t n = LBASE[sym - 257] + in.get(LEXTRA[sym - 257]);
+      int dcode = dist.decode(in);
+      if (dcode < 0 || dcode >= 30) return false;
+      size_t d = DBASE[dcode] + in.get(DEXTRA[dcode]);
+      if (in.over || d > out.size()) return false;
+      for (size_t i = 0; i < n; i++) out.push_back(out[out.size() - d]);
+    }
+  }
+  return true;
+}
+
+static int paeth(int a, int b, int c) {
+  int p = a + b - c, pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+  return pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+}
+
+// Разбор PNG: CRC каждого блока, IHDR, zlib и Adler-32, все пять фильтров
+static bool decodePng(const Bytes &in, int &w, int &h, int &channels, Bytes &px) {
+  static const uint8_t SIGNATURE[8] = { 137, 'P', 'N', 'G', '\r', '\n', 26, '\n' };
+  if (in.size() < 8 || memcmp(in.data(), SIGNATURE, 8) != 0) return false;
+  Bytes z;
+  bool header = false, iend = false;
+  for (size_t p = 8; p < in.size() && !iend;) {
+    if (p + 12 > in.size()) return false;
+    uint32_t len = readBE32(&in[p]);
+    if (p + 12 + len > in.size()) return false;
+    const uint8_t *type = &in[p + 4], *body = &in[p + 8];
+    if (crc32(type, len + 4) != readBE32(body + len)) return false;
+    if (!memcmp(type, "IHDR", 4)) {
+      if (len != 13 || body[8] != 8 || body[10] || body[11] || body[12]) return false;
+      w = (int)readBE32(body);
+      h = (int)readBE32(body + 4);
+      channels = body[9] == 2 ? 3 : body[9] == 0 ? 1 : 0;
+      header = channels != 0;
+    } else if (!memcmp(type, "IDAT", 4)) {
+      z.insert(z.end(), body, body + len);
+    } else if (!memcmp(type, "IEND", 4)) {
+      iend = p + 12 + len == in.size();
+    }
+    p += 12 + len;
+  }
+  if (!header || !iend || z.size() < 6) return false;
+  if ((z[0] & 0x0F) != 8 || (z[0] << 8 | z[1]) % 31 != 0 || (z[1] & 0x20)) return false;
+
+  Bytes raw;
+  if (!inflate(&z[2], z.size() - 6, raw)) return false;
+  uint32_t a = 1, b = 0;
+  for (uint8_t v : raw) { a = (a + v) % 65521; b = (b + a) % 65521; }
+  if ((b << 16 | a) != readBE32(&z[z.size() - 4])) return false;
+
+  size_t stride = (size_t)w * channels;
+  if (raw.size() != (stride + 1) * h) return false;
+  px.assign(stride * h, 0);
+  for (int y = 0; y < h; y++) {
+    int filter = raw[y * (stride + 1)];
+    const uint8_t *src = &raw[y * (stride + 1) + 1];
+    uint8_t *row = &px[y * stride];
+    const uint8_t *up = y ? row - stride : nullptr;
+    for (size_t i = 0; i < stride; i++) {
+      int left = i >= (size_t)channels ? row[i - channels] : 0;
+      int above = up ? up[i] : 0;
+      int corner = up && i >= (size_t)channels ? up[i - channels] : 0;
+      int pred = filter == 0 ? 0 : filter == 1 ? left : filter == 2 ? above :
+                 filter == 3 ? (left + above) / 2 : filter == 4 ? paeth(left, above, corner) : -1;
+      if (pred < 0) return false;
+      row[i] = (uint8_t)(src[i] + pred);
+    }
+  }
+  return true;
+}
+
+// Размер того же кадра в BMP, как у /frame: RGB565 - 16 бит, серый - 8 бит
+// с палитрой
+static size_t bmpSize(int channels) {
+  size_t row = ((size_t)W * (channels == 3 ? 2 : 1) + 3) & ~(size_t)3;
+  return (channels == 1 ? 54 + 1024 : 54) + row * H;
+}
+
+template <class F>
+static double microsPerRun(int runs, F f) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < runs; i++) f();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(t1 - t0).count() / runs;
+}
+
+static uint8_t frame[W * H * 3];
+
+void setUp() {}
+void tearDown() {}
+
+static void checkQoiRoundTrip(int channels, int noise) {
+  makeFrame(frame, channels, noise, 7 + noise);
+  Bytes out, rgb;
+  TEST_ASSERT_TRUE(encode<QoiEncoder>(frame, channels, out));
+  int w = 0, h = 0;
+  TEST_ASSERT_TRUE(decodeQoi(out, w, h, rgb));
+  TEST_ASSERT_EQUAL_INT(W, w);
+  TEST_ASSERT_EQUAL_INT(H, h);
+  for (int i = 0; i < W * H; i++) {
+    for (int c = 0; c < 3; c++) {
+      TEST_ASSERT_EQUAL_UINT8(frame[i * channels + (channels == 3 ? c : 0)], rgb[i * 3 + c]);
+    }
+  }
+}
+
+static void checkPngRoundTrip(int channels, int noise) {
+  makeFrame(frame, channels, noise, 11 + noise);
+  Bytes out, px;
+  TEST_ASSERT_TRUE(encode<PngEncoder>(frame, channels, out));
+  int w = 0, h = 0, ch = 0;
+  TEST_ASSERT_TRUE(decodePng(out, w, h, ch, px));
+  TEST_ASSERT_EQUAL_INT(W, w);
+  TEST_ASSERT_EQUAL_INT(H, h);
+  TEST_ASSERT_EQUAL_INT(channels, ch);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(frame, px.data(), W * H * channels);
+}
+
+void test_qoi_round_trip_rgb() { checkQoiRoundTrip(3, 4); checkQoiRoundTrip(3, 255); }
+void test_qoi_round_trip_gray() { checkQoiRoundTrip(1, 4); checkQoiRoundTrip(1, 255); }
+void test_png_round_trip_rgb() { checkPngRoundTrip(3, 4); checkPngRoundTrip(3, 255); }
+void test_png_round_trip_gray() { checkPngRoundTrip(1, 4); checkPngRoundTrip(1, 255); }
+
+// Ровный кадр: длинные серии в обоих кодерах, в PNG - совпадения по 258 байт
+void test_flat_frame_round_trip() {
+  memset(frame, 0, sizeof(frame));
+  Bytes out, px;
+  int w, h, ch;
+  TEST_ASSERT_TRUE(encode<PngEncoder>(frame, 3, out));
+  TEST_ASSERT_TRUE(decodePng(out, w, h, ch, px));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(frame, px.data(), W * H * 3);
+  TEST_ASSERT_TRUE(encode<QoiEncoder>(frame, 3, out));
+  TEST_ASSERT_TRUE(decodeQoi(out, w, h, px));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(frame, px.data(), W * H * 3);
+}
+
+// Сокет оборвался - кодер сообщает об ошибке и больше ничего не пишет
+void test_short_writer_stops_encoder() {
+  makeFrame(frame, 3, 4, 1);
+  ShortWriter sw = { 1000, 0 };
+  PngEncoder png(toShortWriter, &sw);
+  TEST_ASSERT_TRUE(png.begin(W, H, 3));
+  for (int y = 0; y < H; y++) png.writeRow(frame + y * W * 3);
+  TEST_ASSERT_FALSE(png.end());
+  TEST_ASSERT_FALSE(png.ok());
+  TEST_ASSERT_EQUAL_UINT32(1000, sw.written);
+
+  ShortWriter sq = { 100, 0 };
+  QoiEncoder qoi(toShortWriter, &sq);
+  TEST_ASSERT_TRUE(qoi.begin(W, H, 3));
+  for (int y = 0; y < H; y++) qoi.writeRow(frame + y * W * 3);
+  TEST_ASSERT_FALSE(qoi.end());
+  TEST_ASSERT_EQUAL_UINT32(100, sq.written);
+}
+
+void test_bad_geometry_is_rejected() {
+  Bytes out;
+  QoiEncoder qoi(toBytes, &out);
+  PngEncoder png(toBytes, &out);
+  TEST_ASSERT_FALSE(qoi.begin(0, H, 3));
+  TEST_ASSERT_FALSE(png.begin(W, H, 2));
+  TEST_ASSERT_FALSE(png.writeRow(frame));
+  TEST_ASSERT_EQUAL_size_t(0, out.size());
+}
+
+// Размер против BMP и время кодирования кадра при разном шуме фона. Оба
+// кодера должны быть меньше BMP до шума +-4; дальше - только цифры
+void test_bench_sizes_and_time() {
+  const int RUNS = 200;
+  const int NOISE[] = { 0, 1, 2, 4, 8 };
+  Bytes out;
+  for (int channels = 3; channels >= 1; channels -= 2) {
+    for (int noise : NOISE) {
+      makeFrame(frame, channels, noise, 99);
+      TEST_ASSERT_TRUE(encode<QoiEncoder>(frame, channels, out));
+      size_t qoiSize = out.size();
+      double qoiUs = microsPerRun(RUNS, [&] { encode<QoiEncoder>(frame, channels, out); });
+      TEST_ASSERT_TRUE(encode<PngEncoder>(frame, channels, out));
+      size_t pngSize = out.size();
+      double pngUs = microsPerRun(RUNS, [&] { encode<PngEncoder>(frame, channels, out); });
+
+      char msg[200];
+      snprintf(msg, sizeof(msg), "%dx%d %s noise +-%d: BMP %u B, QOI %u B in %.0f us, PNG %u B in %.0f us",
+               W, H, channels == 3 ? "rgb" : "gray", noise, (unsigned)bmpSize(channels),
+               (unsigned)qoiSize, qoiUs, (unsigned)pngSize, pngUs);
+      TEST_MESSAGE(msg);
+      if (noise <= 4) {
+        TEST_ASSERT_LESS_THAN((int)bmpSize(channels), (int)qoiSize);
+        TEST_ASSERT_LESS_THAN((int)bmpSize(channels), (int)pngSize);
+      }
+    }
+  }
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_qoi_round_trip_rgb);
+  RUN_TEST(test_qoi_round_trip_gray);
+  RUN_TEST(test_png_round_trip_rgb);
+  RUN_TEST(test_png_round_trip_gray);
+  RUN_TEST(test_flat_frame_round_trip);
+  RUN_TEST(test_short_writer_stops_encoder);
+  RUN_TEST(test_bad_geometry_is_rejected);
+  RUN_TEST(test_bench_sizes_and_time);
+  return UNITY_END();
+}
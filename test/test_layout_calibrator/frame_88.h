@@ -0,0 +1,509 @@
+#ifndef TEST_FRAME_88_H
+#define TEST_FRAME_88_H
+
+#include <stdint.h>
+
+// Калибровочный кадр "88" в ROI по умолчанию: 140x70, яркость 8 бит, строки
+// сверху вниз (по 7 строк исходника на строку кадра). Снимка с камеры в
+// дереве нет, поэтому кадр построен по разметке по умолчанию так, как её
+// видит камера: сегменты на пиксель длиннее прямоугольников выборки,
+// расфокус (размытие 3x3), фон с перепадом 35..65 по кадру и шум с
+// отклонением 5. Снятый кадр подставляется сюда в том же виде: серый PNG
+// из /frame?x=10&y=48&w=140&h=70&overlay=0&fmt=png, байт на точку.
+const int FRAME_88_W = 140;
+const int FRAME_88_H = 70;
+
+static const uint8_t FRAME_88[FRAME_88_W * FRAME_88_H] = {
+  32, 37, 41, 31, 28, 34, 40, 30, 46, 48, 38, 38, 39, 41, 36, 35, 40, 42, 39, 36,
+  41, 36, 41, 36, 51, 31, 46, 38, 47, 37, 45, 40, 36, 43, 34, 40, 38, 42, 37, 42,
+  41, 40, 45, 46, 45, 44, 38, 29, 41, 43, 38, 43, 39, 49, 39, 46, 41, 38, 39, 41,
+  37, 45, 53, 42, 52, 40, 49, 46, 45, 50, 46, 37, 47, 46, 45, 47, 43, 45, 53, 46,
+  46, 41, 44, 47, 37, 56, 55, 45, 46, 45, 58, 48, 46, 55, 46, 59, 47, 59, 52, 48,
+  49, 48, 48, 53, 45, 54, 53, 56, 44, 55, 50, 47, 52, 50, 55, 49, 48, 61, 48, 56,
+  50, 48, 54, 48, 49, 56, 51, 55, 52, 58, 62, 52, 55, 44, 57, 63, 57, 57, 61, 59,
+  28, 38, 40, 50, 33, 37, 34, 34, 37, 34, 34, 44, 34, 32, 39, 39, 41, 35, 30, 35,
+  38, 42, 45, 32, 35, 42, 45, 39, 41, 24, 34, 44, 44, 32, 39, 43, 42, 35, 40, 33,
+  36, 43, 42, 46, 42, 32, 42, 46, 46, 32, 41, 47, 44, 40, 45, 38, 44, 48, 42, 48,
+  45, 52, 44, 45, 45, 50, 46, 44, 46, 41, 43, 51, 47, 46, 48, 43, 51, 46, 52, 46,
+  38, 44, 46, 51, 41, 50, 55, 43, 40, 46, 46, 45, 54, 52, 55, 50, 53, 53, 40, 54,
+  47, 52, 42, 50, 50, 47, 54, 44, 56, 52, 53, 47, 54, 53, 55, 58, 42, 45, 50, 54,
+  59, 56, 56, 51, 50, 49, 64, 44, 47, 51, 42, 57, 56, 55, 47, 56, 56, 53, 64, 54,
+  37, 32, 34, 45, 45, 35, 31, 30, 41, 45, 33, 41, 34, 34, 42, 34, 32, 38, 32, 33,
+  32, 44, 45, 39, 43, 46, 37, 44, 41, 48, 30, 45, 38, 34, 47, 42, 38, 39, 39, 35,
+  38, 44, 45, 47, 41, 43, 44, 45, 39, 45, 47, 53, 37, 35, 53, 36, 37, 50, 46, 57,
+  51, 45, 40, 39, 49, 44, 46, 47, 52, 46, 40, 54, 51, 47, 51, 48, 49, 53, 52, 49,
+  41, 44, 42, 54, 50, 47, 54, 49, 48, 49, 48, 50, 59, 50, 47, 40, 58, 56, 47, 43,
+  52, 49, 52, 49, 48, 40, 55, 46, 58, 47, 62, 58, 56, 51, 55, 44, 50, 45, 56, 50,
+  50, 45, 56, 54, 47, 60, 51, 50, 55, 53, 60, 52, 52, 55, 52, 60, 54, 55, 55, 54,
+  29, 35, 40, 42, 38, 45, 45, 36, 38, 41, 30, 39, 43, 35, 40, 30, 33, 40, 38, 34,
+  36, 39, 35, 45, 41, 35, 30, 43, 46, 36, 44, 40, 44, 37, 42, 36, 38, 42, 44, 38,
+  31, 38, 48, 40, 34, 47, 40, 39, 47, 40, 38, 41, 32, 40, 39, 45, 29, 38, 51, 41,
+  48, 41, 49, 44, 40, 42, 37, 48, 49, 39, 45, 44, 52, 41, 43, 42, 50, 41, 48, 44,
+  51, 39, 55, 44, 47, 47, 33, 47, 43, 48, 52, 47, 55, 41, 48, 51, 53, 50, 48, 44,
+  56, 52, 51, 46, 56, 46, 52, 43, 50, 59, 47, 55, 45, 56, 57, 47, 45, 52, 49, 51,
+  64, 53, 53, 57, 59, 46, 59, 63, 52, 56, 58, 59, 48, 56, 49, 60, 50, 62, 54, 52,
+  30, 34, 37, 37, 29, 27, 38, 40, 37, 32, 40, 34, 25, 36, 30, 41, 28, 45, 39, 34,
+  44, 43, 31, 36, 48, 39, 48, 36, 34, 50, 33, 43, 40, 37, 44, 41, 39, 46, 40, 39,
+  41, 36, 43, 37, 36, 39, 44, 44, 45, 47, 45, 35, 48, 50, 47, 40, 41, 35, 46, 41,
+  44, 37, 43, 40, 53, 46, 44, 45, 47, 53, 40, 52, 43, 38, 40, 41, 55, 52, 44, 48,
+  52, 47, 49, 36, 46, 41, 49, 43, 39, 50, 54, 57, 44, 44, 54, 49, 46, 55, 54, 49,
+  61, 59, 49, 55, 50, 53, 50, 55, 53, 52, 49, 49, 49, 47, 61, 49, 49, 59, 61, 54,
+  49, 57, 49, 57, 56, 63, 52, 52, 59, 63, 55, 46, 55, 58, 49, 66, 60, 53, 55, 53,
+  34, 37, 32, 35, 35, 41, 42, 44, 39, 42, 36, 43, 46, 38, 32, 35, 41, 32, 42, 31,
+  42, 38, 36, 44, 37, 32, 30, 40, 43, 40, 44, 40, 42, 39, 34, 39, 33, 39, 53, 41,
+  36, 51, 42, 45, 44, 42, 31, 47, 45, 42, 41, 45, 36, 44, 34, 49, 41, 42, 37, 47,
+  47, 37, 41, 53, 48, 38, 51, 42, 48, 47, 46, 46, 40, 58, 42, 42, 49, 49, 39, 40,
+  50, 48, 49, 52, 46, 51, 51, 40, 47, 51, 48, 47, 43, 54, 59, 54, 56, 57, 44, 52,
+  60, 48, 54, 43, 56, 58, 50, 47, 53, 52, 49, 50, 50, 45, 52, 57, 65, 56, 54, 48,
+  45, 55, 56, 52, 57, 60, 51, 49, 49, 55, 63, 54, 59, 59, 59, 54, 56, 60, 60, 58,
+  25, 40, 34, 42, 29, 35, 34, 34, 47, 45, 33, 38, 39, 34, 39, 34, 37, 46, 35, 37,
+  42, 43, 38, 41, 47, 44, 36, 37, 41, 42, 38, 43, 41, 41, 42, 38, 40, 38, 39, 49,
+  51, 35, 33, 38, 37, 43, 42, 44, 48, 43, 44, 52, 38, 46, 52, 37, 42, 37, 43, 39,
+  40, 53, 52, 40, 42, 46, 45, 58, 46, 49, 40, 56, 40, 51, 39, 43, 45, 55, 52, 42,
+  40, 55, 48, 42, 42, 46, 45, 54, 44, 49, 51, 40, 48, 47, 45, 51, 52, 57, 47, 60,
+  49, 48, 52, 48, 60, 45, 48, 53, 50, 52, 50, 51, 55, 55, 62, 53, 48, 46, 52, 60,
+  53, 61, 53, 55, 48, 55, 51, 55, 57, 56, 59, 54, 64, 50, 59, 53, 65, 49, 56, 57,
+  36, 46, 38, 26, 50, 40, 38, 32, 33, 40, 29, 29, 45, 32, 34, 34, 28, 37, 33, 44,
+  46, 43, 41, 42, 37, 47, 33, 35, 37, 33, 48, 31, 41, 33, 45, 39, 34, 39, 41, 42,
+  36, 50, 47, 31, 45, 45, 41, 41, 39, 36, 39, 40, 42, 42, 43, 40, 39, 51, 50, 50,
+  44, 48, 38, 35, 49, 46, 39, 42, 39, 43, 45, 46, 50, 53, 42, 53, 42, 46, 47, 43,
+  35, 46, 46, 41, 44, 50, 39, 56, 54, 46, 50, 53, 55, 39, 45, 55, 49, 46, 49, 47,
+  53, 54, 47, 51, 43, 43, 52, 49, 56, 52, 52, 49, 48, 48, 52, 53, 62, 51, 54, 48,
+  47, 49, 47, 62, 51, 48, 53, 51, 55, 60, 53, 53, 48, 51, 63, 55, 59, 56, 62, 61,
+  34, 32, 27, 35, 30, 36, 26, 37, 31, 44, 37, 44, 39, 32, 37, 42, 28, 33, 34, 39,
+  36, 36, 32, 44, 33, 38, 36, 36, 49, 37, 38, 33, 40, 32, 37, 41, 38, 31, 39, 37,
+  34, 44, 44, 48, 48, 38, 35, 43, 41, 41, 31, 47, 45, 35, 44, 43, 52, 50, 45, 48,
+  42, 38, 51, 40, 46, 55, 39, 49, 54, 44, 60, 41, 48, 40, 44, 48, 51, 48, 45, 44,
+  53, 50, 43, 51, 41, 36, 43, 59, 39, 52, 46, 51, 48, 54, 51, 53, 49, 47, 63, 51,
+  51, 56, 52, 50, 55, 51, 54, 50, 45, 49, 57, 52, 47, 43, 49, 51, 54, 59, 49, 53,
+  57, 49, 53, 44, 58, 45, 60, 49, 48, 59, 56, 52, 62, 55, 49, 46, 62, 53, 67, 56,
+  41, 41, 35, 31, 42, 37, 35, 36, 25, 39, 42, 29, 40, 42, 38, 38, 35, 37, 33, 41,
+  45, 40, 36, 38, 40, 41, 45, 38, 42, 46, 36, 25, 38, 41, 43, 45, 44, 52, 40, 46,
+  30, 44, 41, 40, 40, 43, 42, 41, 42, 35, 41, 49, 42, 48, 43, 39, 49, 38, 42, 48,
+  37, 48, 49, 46, 52, 49, 46, 44, 46, 47, 44, 44, 47, 51, 42, 43, 45, 56, 49, 45,
+  54, 57, 42, 53, 52, 50, 54, 45, 55, 56, 51, 45, 53, 54, 55, 48, 48, 44, 55, 48,
+  37, 55, 65, 57, 42, 55, 56, 49, 59, 60, 56, 53, 49, 49, 52, 53, 53, 52, 61, 49,
+  62, 55, 55, 53, 44, 50, 54, 53, 48, 61, 55, 55, 55, 60, 61, 56, 54, 55, 62, 64,
+  35, 44, 34, 42, 36, 38, 40, 35, 35, 37, 38, 45, 37, 39, 39, 46, 69, 78, 78, 87,
+  65, 56, 34, 43, 36, 37, 33, 36, 42, 45, 36, 36, 38, 46, 48, 38, 43, 51, 47, 36,
+  54, 71, 90, 87, 84, 80, 44, 37, 45, 41, 45, 37, 49, 41, 40, 50, 34, 49, 39, 55,
+  45, 46, 45, 45, 52, 52, 61, 81, 90, 88, 85, 70, 49, 45, 44, 48, 46, 52, 37, 50,
+  43, 55, 38, 46, 38, 48, 52, 43, 45, 48, 56, 52, 57, 86, 90, 89, 85, 73, 67, 48,
+  45, 46, 52, 56, 53, 46, 54, 48, 53, 56, 60, 55, 42, 52, 57, 60, 57, 49, 65, 78,
+  89, 101, 96, 88, 69, 45, 50, 52, 55, 54, 58, 56, 52, 59, 51, 48, 57, 63, 54, 60,
+  29, 36, 42, 38, 37, 32, 37, 35, 39, 37, 43, 34, 44, 39, 44, 75, 130, 176, 167, 168,
+  146, 75, 43, 31, 35, 40, 35, 46, 41, 39, 43, 32, 51, 44, 36, 45, 44, 46, 40, 37,
+  80, 140, 164, 177, 172, 137, 77, 33, 45, 42, 49, 45, 40, 52, 45, 46, 46, 52, 46, 42,
+  44, 51, 46, 35, 46, 49, 81, 148, 177, 185, 179, 144, 75, 48, 48, 42, 53, 47, 44, 54,
+  47, 39, 38, 53, 55, 54, 51, 51, 56, 56, 45, 54, 85, 139, 170, 173, 178, 150, 81, 52,
+  49, 50, 50, 55, 58, 56, 61, 58, 50, 63, 52, 57, 55, 64, 50, 49, 59, 59, 95, 148,
+  184, 169, 179, 140, 86, 48, 47, 57, 59, 55, 53, 55, 54, 51, 56, 59, 52, 59, 46, 58,
+  38, 40, 35, 34, 39, 34, 41, 34, 31, 31, 42, 36, 45, 35, 40, 89, 170, 219, 206, 220,
+  170, 90, 35, 46, 34, 34, 48, 43, 37, 47, 49, 42, 38, 41, 37, 42, 36, 32, 41, 38,
+  87, 170, 218, 214, 222, 180, 86, 50, 44, 36, 39, 48, 49, 43, 52, 43, 41, 49, 43, 50,
+  44, 38, 45, 42, 48, 43, 95, 174, 217, 211, 219, 176, 97, 44, 56, 53, 47, 44, 41, 44,
+  46, 48, 48, 42, 43, 46, 42, 48, 46, 46, 50, 47, 89, 167, 222, 215, 224, 177, 85, 47,
+  44, 41, 46, 47, 60, 49, 49, 46, 53, 53, 50, 46, 55, 49, 49, 49, 56, 54, 90, 186,
+  214, 215, 213, 184, 101, 63, 56, 60, 44, 55, 52, 47, 56, 63, 47, 61, 51, 59, 62, 53,
+  37, 40, 34, 33, 44, 34, 36, 42, 44, 38, 43, 32, 38, 36, 40, 79, 176, 226, 214, 228,
+  177, 78, 39, 48, 40, 43, 45, 45, 42, 40, 39, 38, 40, 48, 31, 37, 45, 44, 37, 39,
+  85, 174, 217, 214, 218, 170, 86, 46, 47, 45, 42, 44, 46, 46, 34, 47, 45, 43, 47, 50,
+  44, 38, 45, 42, 44, 49, 87, 173, 224, 208, 215, 164, 90, 49, 49, 53, 52, 49, 47, 43,
+  56, 53, 45, 53, 54, 44, 43, 57, 52, 51, 49, 42, 88, 171, 230, 223, 217, 175, 84, 54,
+  49, 55, 53, 50, 56, 50, 58, 46, 53, 45, 47, 50, 67, 62, 49, 54, 50, 58, 99, 177,
+  213, 220, 222, 166, 91, 55, 58, 57, 44, 54, 60, 53, 53, 45, 61, 55, 49, 62, 58, 65,
+  36, 36, 34, 38, 43, 35, 34, 35, 37, 38, 42, 37, 35, 34, 45, 80, 168, 223, 219, 216,
+  171, 82, 39, 41, 43, 42, 46, 29, 35, 45, 48, 48, 48, 34, 33, 40, 44, 49, 42, 39,
+  92, 168, 220, 229, 216, 174, 84, 41, 50, 42, 42, 47, 40, 47, 50, 48, 46, 44, 53, 41,
+  46, 54, 48, 52, 53, 34, 94, 169, 199, 210, 206, 176, 95, 46, 50, 45, 41, 49, 42, 45,
+  48, 48, 46, 51, 53, 50, 51, 54, 61, 50, 48, 54, 92, 176, 220, 223, 216, 166, 99, 50,
+  49, 57, 48, 55, 58, 54, 53, 49, 56, 49, 54, 47, 48, 56, 55, 52, 61, 51, 81, 179,
+  215, 222, 219, 173, 89, 50, 53, 63, 58, 60, 58, 56, 57, 55, 53, 55, 55, 44, 47, 57,
+  46, 35, 36, 38, 34, 35, 35, 33, 40, 42, 34, 38, 43, 39, 41, 70, 135, 175, 175, 169,
+  129, 74, 46, 43, 36, 39, 43, 41, 45, 36, 30, 45, 38, 44, 43, 47, 37, 42, 48, 44,
+  82, 124, 181, 178, 162, 138, 75, 40, 41, 47, 45, 31, 35, 47, 42, 44, 43, 52, 51, 47,
+  46, 45, 39, 55, 43, 51, 82, 132, 173, 177, 179, 144, 86, 50, 50, 54, 45, 52, 45, 47,
+  60, 47, 39, 49, 47, 56, 51, 53, 54, 45, 53, 54, 83, 154, 173, 178, 164, 142, 74, 50,
+  46, 49, 59, 47, 49, 56, 61, 56, 53, 50, 62, 54, 57, 62, 54, 60, 55, 52, 89, 147,
+  180, 178, 181, 154, 86, 50, 59, 54, 57, 42, 58, 55, 62, 48, 56, 51, 58, 46, 63, 52,
+  41, 40, 35, 30, 38, 43, 37, 41, 43, 31, 44, 30, 41, 43, 46, 54, 69, 76, 78, 83,
+  81, 53, 38, 46, 42, 41, 35, 42, 37, 47, 44, 39, 36, 42, 46, 40, 41, 48, 43, 49,
+  57, 80, 93, 87, 86, 73, 55, 40, 45, 48, 45, 48, 47, 46, 47, 52, 50, 42, 49, 45,
+  45, 50, 41, 42, 52, 48, 58, 70, 85, 87, 95, 74, 65, 48, 47, 49, 46, 44, 51, 59,
+  53, 44, 53, 52, 51, 53, 48, 51, 39, 52, 37, 51, 64, 78, 94, 92, 92, 91, 57, 56,
+  50, 49, 58, 49, 50, 47, 48, 45, 52, 56, 43, 56, 53, 53, 51, 65, 51, 56, 67, 88,
+  103, 93, 100, 85, 65, 53, 54, 67, 64, 59, 52, 64, 56, 50, 56, 63, 54, 56, 59, 55,
+  37, 40, 39, 37, 38, 51, 51, 35, 46, 40, 33, 32, 36, 29, 35, 44, 43, 36, 40, 35,
+  38, 48, 46, 41, 41, 46, 44, 45, 37, 44, 36, 29, 48, 39, 48, 48, 36, 43, 33, 45,
+  43, 45, 48, 45, 47, 37, 44, 48, 45, 42, 43, 40, 37, 47, 46, 37, 55, 44, 44, 52,
+  52, 41, 51, 48, 51, 49, 41, 52, 43, 56, 54, 52, 44, 43, 43, 46, 46, 49, 49, 49,
+  53, 50, 55, 46, 56, 48, 45, 47, 48, 51, 45, 49, 44, 49, 36, 47, 47, 35, 49, 55,
+  55, 44, 53, 52, 45, 53, 61, 49, 55, 60, 59, 56, 60, 52, 47, 50, 50, 58, 55, 53,
+  62, 50, 41, 55, 57, 59, 53, 59, 67, 50, 60, 51, 62, 51, 47, 67, 52, 59, 62, 58,
+  41, 29, 45, 43, 34, 30, 28, 47, 46, 35, 43, 31, 32, 35, 41, 37, 35, 45, 38, 45,
+  46, 42, 39, 43, 42, 45, 39, 41, 39, 34, 36, 36, 43, 43, 49, 34, 45, 40, 45, 42,
+  47, 40, 49, 37, 40, 54, 43, 47, 45, 40, 49, 45, 33, 44, 41, 55, 46, 45, 44, 44,
+  49, 49, 44, 47, 50, 52, 39, 37, 49, 46, 52, 55, 42, 50, 55, 50, 38, 57, 49, 49,
+  39, 44, 41, 48, 45, 49, 44, 42, 47, 53, 50, 53, 48, 48, 47, 47, 40, 42, 58, 56,
+  50, 48, 53, 52, 47, 46, 60, 51, 59, 50, 44, 50, 54, 45, 58, 53, 50, 54, 48, 58,
+  55, 62, 60, 56, 55, 58, 50, 51, 62, 53, 53, 59, 72, 49, 60, 51, 52, 57, 55, 64,
+  38, 43, 32, 33, 35, 32, 35, 41, 30, 34, 33, 34, 38, 38, 39, 45, 44, 47, 37, 51,
+  45, 39, 38, 39, 45, 38, 56, 39, 45, 39, 40, 44, 40, 40, 44, 34, 44, 40, 45, 46,
+  52, 34, 42, 49, 45, 49, 53, 39, 47, 45, 54, 49, 41, 43, 39, 35, 56, 40, 41, 41,
+  47, 47, 48, 49, 47, 52, 47, 48, 48, 50, 41, 42, 49, 55, 58, 38, 55, 47, 43, 54,
+  48, 49, 54, 40, 50, 58, 59, 61, 53, 52, 56, 50, 54, 54, 51, 53, 55, 44, 55, 52,
+  51, 53, 53, 43, 51, 51, 45, 53, 60, 49, 56, 55, 52, 65, 52, 52, 52, 57, 43, 59,
+  52, 48, 57, 49, 49, 55, 60, 52, 61, 51, 51, 66, 52, 45, 65, 61, 56, 60, 54, 59,
+  40, 44, 45, 36, 47, 28, 36, 34, 43, 40, 37, 48, 34, 38, 42, 45, 30, 39, 36, 44,
+  47, 46, 48, 39, 42, 47, 37, 51, 44, 44, 42, 40, 42, 38, 42, 46, 44, 52, 51, 52,
+  45, 36, 40, 44, 45, 49, 39, 43, 49, 44, 41, 36, 40, 49, 46, 48, 56, 47, 48, 50,
+  40, 42, 50, 47, 51, 43, 56, 46, 55, 53, 55, 52, 48, 43, 55, 48, 50, 52, 52, 48,
+  47, 46, 43, 43, 49, 55, 53, 52, 55, 45, 56, 55, 50, 52, 50, 48, 51, 41, 56, 51,
+  50, 53, 45, 60, 51, 54, 52, 48, 50, 52, 52, 51, 58, 57, 58, 58, 64, 59, 59, 61,
+  53, 51, 55, 58, 56, 54, 53, 57, 55, 61, 59, 56, 51, 61, 55, 63, 61, 59, 52, 54,
+  37, 41, 38, 45, 41, 42, 34, 41, 39, 32, 32, 38, 35, 39, 42, 43, 47, 36, 42, 37,
+  42, 44, 40, 44, 40, 32, 39, 44, 42, 50, 49, 42, 35, 37, 46, 43, 49, 39, 40, 51,
+  48, 43, 47, 46, 48, 41, 40, 44, 37, 44, 40, 37, 50, 53, 46, 47, 41, 48, 46, 49,
+  48, 46, 44, 48, 49, 49, 50, 46, 46, 46, 46, 45, 45, 46, 53, 52, 49, 55, 50, 51,
+  47, 54, 52, 39, 43, 52, 45, 44, 52, 53, 54, 49, 61, 54, 51, 49, 52, 57, 47, 56,
+  56, 46, 47, 56, 59, 63, 47, 49, 50, 57, 58, 56, 54, 58, 47, 62, 53, 54, 57, 57,
+  51, 56, 63, 67, 64, 58, 57, 59, 59, 52, 48, 55, 56, 60, 55, 64, 57, 54, 53, 61,
+  47, 39, 30, 41, 37, 34, 42, 26, 40, 41, 40, 41, 35, 42, 30, 47, 48, 35, 37, 39,
+  41, 34, 41, 42, 43, 44, 42, 39, 53, 40, 37, 38, 33, 36, 48, 45, 47, 41, 49, 49,
+  43, 43, 38, 45, 47, 44, 49, 51, 49, 52, 50, 46, 55, 43, 39, 48, 44, 50, 46, 39,
+  53, 51, 34, 45, 53, 48, 48, 48, 39, 49, 51, 47, 51, 46, 47, 50, 41, 52, 50, 43,
+  55, 57, 54, 43, 53, 52, 43, 48, 47, 47, 58, 58, 54, 48, 57, 52, 60, 54, 52, 49,
+  53, 47, 53, 65, 44, 54, 54, 55, 57, 58, 59, 55, 50, 53, 58, 55, 43, 55, 56, 47,
+  58, 43, 50, 58, 56, 59, 50, 61, 52, 59, 61, 63, 53, 55, 60, 59, 60, 52, 59, 60,
+  38, 26, 29, 31, 44, 41, 33, 30, 35, 34, 39, 39, 36, 30, 40, 40, 39, 39, 40, 44,
+  42, 42, 37, 50, 43, 37, 42, 43, 39, 40, 41, 38, 37, 45, 35, 46, 40, 38, 46, 39,
+  39, 52, 48, 45, 46, 49, 30, 38, 45, 44, 45, 48, 45, 44, 50, 47, 53, 43, 35, 35,
+  46, 53, 50, 56, 47, 48, 50, 56, 47, 51, 51, 51, 43, 47, 45, 48, 49, 56, 58, 54,
+  45, 49, 56, 58, 59, 48, 53, 53, 53, 41, 60, 45, 55, 57, 51, 39, 52, 49, 57, 62,
+  48, 46, 58, 54, 52, 44, 43, 62, 55, 51, 49, 55, 49, 60, 51, 63, 65, 47, 60, 50,
+  51, 63, 51, 54, 51, 61, 54, 57, 51, 59, 51, 52, 57, 55, 53, 54, 61, 51, 61, 55,
+  31, 43, 45, 34, 45, 39, 44, 36, 31, 38, 43, 42, 33, 36, 45, 42, 40, 49, 29, 41,
+  37, 45, 42, 37, 41, 38, 34, 39, 35, 42, 46, 45, 38, 33, 52, 46, 49, 48, 39, 41,
+  36, 42, 35, 52, 47, 41, 47, 45, 50, 46, 41, 46, 54, 45, 52, 48, 49, 46, 51, 38,
+  46, 46, 45, 41, 50, 47, 47, 48, 52, 46, 51, 51, 56, 42, 51, 47, 51, 51, 54, 50,
+  46, 57, 50, 45, 50, 49, 50, 47, 43, 49, 56, 54, 57, 51, 52, 52, 61, 60, 50, 47,
+  57, 55, 53, 54, 58, 54, 53, 54, 52, 62, 50, 50, 54, 49, 59, 57, 57, 52, 58, 60,
+  60, 57, 58, 49, 57, 55, 61, 67, 61, 54, 53, 50, 61, 60, 61, 43, 61, 69, 52, 55,
+  54, 45, 37, 40, 35, 42, 40, 35, 39, 48, 33, 40, 39, 38, 35, 40, 44, 38, 44, 40,
+  41, 43, 41, 35, 49, 46, 43, 51, 46, 45, 40, 28, 42, 37, 35, 39, 40, 54, 40, 38,
+  42, 46, 43, 47, 53, 42, 43, 46, 39, 48, 51, 46, 48, 46, 54, 56, 52, 43, 52, 38,
+  49, 47, 45, 43, 44, 46, 46, 54, 42, 45, 45, 46, 48, 53, 43, 50, 52, 44, 44, 52,
+  51, 49, 43, 46, 48, 64, 52, 58, 60, 56, 46, 53, 56, 49, 54, 55, 49, 50, 47, 57,
+  46, 47, 64, 54, 59, 58, 43, 61, 47, 54, 43, 57, 51, 58, 61, 61, 59, 60, 57, 54,
+  66, 55, 52, 62, 54, 53, 58, 54, 59, 47, 51, 64, 57, 59, 60, 64, 54, 46, 59, 60,
+  29, 40, 37, 47, 27, 33, 35, 33, 41, 41, 41, 39, 36, 43, 50, 31, 48, 47, 45, 36,
+  61, 48, 43, 32, 40, 40, 42, 42, 40, 43, 42, 49, 42, 45, 49, 50, 41, 39, 52, 50,
+  35, 47, 42, 42, 40, 47, 43, 35, 51, 55, 48, 47, 47, 46, 51, 38, 44, 52, 42, 47,
+  59, 52, 50, 36, 52, 48, 57, 54, 58, 48, 44, 47, 40, 42, 51, 49, 59, 45, 58, 48,
+  45, 62, 52, 56, 48, 45, 44, 52, 54, 44, 49, 55, 58, 49, 49, 49, 54, 67, 52, 53,
+  52, 49, 61, 58, 59, 56, 51, 59, 56, 59, 47, 47, 51, 46, 61, 55, 58, 50, 55, 56,
+  55, 71, 65, 62, 53, 62, 55, 55, 58, 58, 58, 64, 56, 60, 54, 67, 61, 65, 63, 60,
+  46, 45, 43, 48, 39, 42, 39, 36, 38, 52, 43, 41, 44, 45, 48, 44, 44, 42, 48, 38,
+  50, 45, 36, 37, 55, 43, 49, 43, 45, 44, 40, 43, 42, 37, 51, 44, 42, 50, 43, 45,
+  41, 50, 43, 55, 36, 42, 52, 48, 46, 46, 37, 38, 52, 51, 46, 38, 40, 46, 48, 46,
+  52, 47, 42, 41, 47, 48, 58, 47, 64, 49, 47, 53, 53, 59, 44, 44, 48, 50, 54, 59,
+  47, 47, 57, 56, 54, 56, 55, 54, 49, 49, 51, 53, 48, 48, 50, 47, 48, 48, 44, 54,
+  50, 55, 52, 45, 51, 51, 49, 55, 59, 55, 53, 56, 56, 61, 45, 53, 63, 58, 59, 60,
+  54, 59, 57, 54, 65, 61, 70, 57, 49, 59, 50, 53, 56, 67, 47, 60, 63, 54, 55, 61,
+  39, 34, 42, 34, 35, 37, 38, 43, 34, 35, 42, 36, 47, 43, 50, 45, 34, 40, 45, 43,
+  40, 35, 39, 40, 40, 35, 43, 44, 40, 40, 48, 40, 43, 44, 34, 49, 47, 44, 45, 37,
+  42, 39, 46, 36, 49, 45, 46, 50, 47, 48, 57, 50, 48, 47, 39, 39, 36, 47, 42, 52,
+  44, 43, 42, 61, 48, 56, 48, 54, 49, 47, 52, 51, 46, 47, 42, 54, 51, 56, 56, 53,
+  47, 54, 59, 49, 50, 50, 51, 51, 50, 51, 48, 53, 51, 56, 49, 61, 48, 56, 54, 47,
+  56, 62, 43, 52, 48, 60, 53, 59, 52, 53, 44, 48, 55, 62, 51, 50, 61, 60, 64, 57,
+  54, 65, 54, 52, 52, 67, 59, 50, 52, 63, 58, 58, 51, 53, 58, 49, 69, 54, 58, 54,
+  46, 38, 40, 40, 44, 36, 36, 40, 42, 42, 36, 41, 38, 41, 36, 45, 44, 44, 47, 40,
+  39, 46, 40, 37, 41, 44, 38, 47, 30, 36, 34, 44, 30, 43, 44, 54, 38, 46, 47, 38,
+  49, 49, 42, 39, 50, 50, 47, 39, 43, 52, 50, 41, 42, 43, 55, 47, 47, 51, 54, 47,
+  45, 33, 48, 47, 51, 44, 52, 48, 57, 49, 43, 45, 52, 52, 49, 49, 50, 47, 36, 56,
+  50, 48, 49, 48, 51, 51, 61, 49, 45, 44, 49, 59, 50, 57, 52, 53, 59, 51, 56, 53,
+  52, 54, 53, 50, 44, 55, 55, 62, 55, 56, 58, 52, 50, 56, 51, 52, 52, 55, 57, 64,
+  53, 59, 54, 58, 64, 56, 61, 52, 48, 61, 46, 60, 61, 50, 54, 50, 59, 61, 55, 66,
+  37, 37, 38, 39, 36, 39, 33, 40, 38, 42, 45, 46, 39, 53, 33, 35, 50, 38, 39, 36,
+  39, 28, 42, 36, 48, 47, 47, 34, 33, 48, 35, 43, 46, 43, 46, 48, 42, 45, 38, 51,
+  47, 43, 39, 44, 50, 46, 44, 46, 41, 46, 49, 47, 43, 56, 39, 58, 44, 40, 45, 51,
+  50, 58, 40, 45, 55, 40, 44, 49, 51, 53, 56, 53, 55, 60, 51, 49, 45, 53, 52, 47,
+  50, 58, 38, 45, 43, 48, 49, 52, 57, 45, 52, 56, 50, 50, 54, 43, 61, 51, 51, 55,
+  51, 58, 61, 44, 59, 47, 52, 50, 51, 61, 50, 62, 60, 51, 65, 53, 53, 52, 67, 61,
+  68, 60, 61, 58, 57, 56, 58, 58, 63, 57, 62, 62, 61, 63, 66, 64, 54, 49, 56, 54,
+  42, 43, 37, 41, 37, 42, 45, 45, 35, 37, 35, 47, 34, 40, 46, 38, 46, 44, 33, 47,
+  49, 38, 33, 37, 43, 39, 45, 44, 45, 39, 47, 46, 44, 39, 37, 35, 49, 55, 38, 49,
+  49, 48, 46, 51, 49, 42, 39, 50, 45, 50, 43, 36, 44, 37, 45, 42, 50, 43, 49, 50,
+  48, 45, 49, 49, 48, 55, 50, 56, 52, 52, 49, 51, 49, 49, 56, 54, 47, 53, 51, 53,
+  51, 51, 47, 49, 45, 52, 53, 57, 46, 53, 52, 57, 58, 52, 57, 57, 50, 54, 49, 58,
+  44, 60, 54, 51, 49, 58, 62, 55, 53, 57, 51, 51, 56, 58, 60, 62, 62, 52, 67, 52,
+  65, 56, 52, 55, 64, 61, 51, 64, 53, 64, 63, 51, 58, 57, 63, 57, 56, 58, 62, 59,
+  44, 40, 41, 43, 35, 32, 43, 39, 44, 39, 43, 38, 41, 42, 37, 40, 43, 42, 34, 39,
+  40, 40, 45, 39, 46, 48, 41, 44, 46, 48, 35, 47, 45, 45, 54, 43, 46, 47, 38, 50,
+  42, 45, 42, 46, 54, 49, 41, 58, 45, 54, 41, 46, 48, 48, 50, 46, 46, 45, 49, 44,
+  47, 56, 51, 49, 49, 48, 45, 40, 46, 37, 51, 45, 48, 47, 41, 58, 45, 53, 49, 57,
+  59, 68, 47, 60, 54, 49, 53, 55, 52, 55, 59, 62, 54, 54, 57, 56, 54, 50, 47, 48,
+  57, 58, 51, 48, 62, 55, 52, 53, 47, 63, 59, 59, 62, 61, 57, 63, 61, 51, 54, 52,
+  53, 55, 67, 62, 59, 55, 60, 53, 61, 63, 61, 54, 54, 56, 58, 59, 64, 63, 64, 56,
+  38, 41, 47, 43, 35, 39, 40, 37, 38, 44, 33, 44, 45, 46, 40, 38, 41, 38, 39, 47,
+  44, 51, 42, 38, 41, 45, 44, 39, 39, 42, 39, 38, 41, 47, 44, 48, 48, 47, 44, 55,
+  50, 38, 35, 40, 42, 51, 48, 50, 41, 54, 51, 45, 44, 50, 48, 55, 59, 55, 49, 52,
+  52, 54, 48, 41, 45, 50, 53, 45, 43, 48, 46, 47, 56, 60, 57, 49, 52, 48, 56, 50,
+  55, 45, 58, 58, 49, 47, 53, 53, 55, 61, 60, 50, 46, 52, 51, 49, 51, 60, 56, 49,
+  53, 55, 55, 54, 56, 44, 61, 54, 53, 56, 49, 55, 58, 55, 54, 67, 63, 51, 55, 52,
+  60, 55, 62, 57, 54, 57, 57, 61, 64, 54, 66, 59, 61, 60, 56, 64, 62, 58, 66, 61,
+  34, 36, 50, 52, 36, 36, 43, 44, 42, 49, 37, 36, 50, 45, 37, 34, 40, 43, 41, 37,
+  40, 31, 47, 31, 50, 45, 44, 42, 48, 36, 35, 39, 51, 49, 50, 52, 51, 47, 51, 45,
+  52, 50, 49, 47, 44, 45, 51, 51, 51, 50, 48, 47, 51, 52, 42, 50, 57, 52, 53, 52,
+  47, 54, 54, 49, 58, 54, 43, 44, 50, 46, 56, 48, 57, 51, 47, 48, 44, 50, 43, 48,
+  43, 50, 45, 54, 56, 59, 51, 54, 54, 48, 55, 53, 52, 59, 61, 52, 50, 58, 58, 51,
+  53, 52, 55, 49, 60, 59, 54, 53, 58, 53, 52, 56, 59, 51, 56, 50, 61, 60, 53, 57,
+  56, 64, 68, 52, 60, 59, 60, 60, 50, 67, 53, 63, 62, 60, 65, 65, 58, 63, 67, 58,
+  42, 44, 35, 42, 47, 38, 37, 45, 40, 39, 43, 47, 35, 42, 44, 39, 40, 43, 42, 39,
+  33, 48, 47, 40, 38, 46, 41, 42, 38, 49, 37, 40, 41, 46, 45, 45, 48, 48, 47, 54,
+  44, 45, 50, 40, 30, 44, 49, 50, 44, 47, 46, 44, 38, 37, 45, 46, 50, 53, 50, 53,
+  50, 49, 50, 49, 38, 57, 48, 57, 55, 51, 54, 54, 53, 53, 44, 46, 50, 50, 48, 53,
+  57, 56, 57, 45, 54, 45, 47, 54, 54, 49, 57, 53, 50, 45, 55, 44, 48, 55, 54, 53,
+  54, 50, 57, 55, 64, 54, 61, 54, 50, 50, 64, 52, 65, 48, 63, 55, 58, 67, 63, 51,
+  59, 62, 56, 56, 55, 54, 57, 55, 58, 65, 65, 62, 63, 52, 54, 45, 59, 64, 63, 57,
+  40, 39, 40, 45, 46, 46, 36, 37, 41, 37, 43, 40, 37, 38, 48, 42, 35, 37, 48, 44,
+  43, 51, 39, 47, 51, 41, 34, 44, 38, 41, 51, 48, 44, 55, 41, 44, 50, 42, 43, 46,
+  48, 37, 32, 54, 46, 49, 56, 47, 51, 39, 48, 46, 42, 50, 43, 58, 70, 89, 88, 87,
+  100, 77, 93, 83, 54, 51, 60, 54, 54, 45, 54, 45, 43, 49, 47, 57, 49, 56, 52, 46,
+  58, 85, 94, 96, 98, 96, 96, 98, 88, 62, 57, 56, 53, 56, 55, 44, 54, 56, 55, 56,
+  52, 60, 58, 54, 64, 45, 57, 52, 65, 52, 52, 59, 59, 47, 54, 50, 60, 62, 59, 49,
+  55, 54, 62, 65, 67, 56, 65, 51, 57, 56, 58, 58, 49, 55, 63, 56, 64, 61, 50, 59,
+  40, 35, 39, 40, 34, 38, 43, 40, 34, 38, 49, 45, 43, 37, 39, 34, 42, 48, 46, 45,
+  44, 49, 48, 49, 45, 35, 26, 39, 44, 42, 55, 50, 46, 44, 45, 49, 40, 45, 48, 43,
+  44, 50, 53, 50, 39, 46, 42, 46, 51, 55, 46, 53, 55, 45, 51, 73, 146, 171, 174, 180,
+  171, 171, 173, 137, 79, 49, 44, 53, 55, 53, 59, 49, 45, 46, 51, 51, 54, 54, 56, 41,
+  77, 141, 179, 180, 173, 175, 179, 172, 147, 76, 52, 51, 56, 45, 61, 52, 57, 56, 54, 42,
+  58, 67, 53, 46, 56, 49, 56, 61, 62, 55, 58, 58, 53, 52, 65, 58, 53, 54, 66, 56,
+  56, 65, 57, 62, 57, 59, 54, 62, 58, 59, 53, 57, 60, 56, 53, 47, 58, 53, 65, 64,
+  32, 39, 42, 43, 41, 35, 40, 42, 42, 43, 34, 40, 52, 38, 39, 40, 47, 53, 45, 40,
+  35, 41, 41, 47, 45, 39, 49, 49, 41, 48, 40, 35, 48, 38, 49, 49, 46, 44, 46, 38,
+  47, 41, 52, 49, 43, 56, 41, 51, 48, 46, 46, 63, 51, 47, 52, 82, 173, 218, 218, 219,
+  213, 216, 224, 166, 94, 42, 56, 56, 55, 49, 48, 51, 48, 57, 51, 54, 50, 60, 46, 48,
+  97, 174, 218, 224, 212, 221, 212, 217, 169, 107, 50, 62, 50, 63, 57, 53, 52, 57, 61, 57,
+  58, 56, 53, 56, 55, 55, 56, 62, 51, 50, 61, 50, 58, 56, 60, 55, 52, 57, 56, 53,
+  61, 57, 54, 52, 57, 58, 56, 56, 55, 51, 56, 61, 62, 58, 62, 58, 65, 51, 60, 57,
+  30, 46, 41, 41, 42, 47, 45, 42, 38, 43, 38, 47, 33, 50, 40, 45, 42, 29, 45, 45,
+  44, 39, 43, 37, 48, 45, 39, 42, 48, 39, 43, 41, 51, 45, 36, 39, 51, 45, 40, 46,
+  50, 40, 39, 38, 55, 49, 59, 51, 49, 50, 54, 82, 89, 87, 60, 73, 145, 177, 173, 174,
+  170, 175, 168, 137, 73, 57, 48, 43, 50, 47, 49, 52, 46, 46, 44, 59, 90, 96, 87, 60,
+  83, 151, 181, 180, 171, 178, 176, 171, 147, 77, 54, 59, 55, 59, 63, 53, 57, 54, 60, 54,
+  60, 49, 52, 61, 63, 61, 51, 59, 63, 56, 55, 57, 54, 61, 57, 50, 66, 62, 60, 53,
+  65, 60, 59, 55, 66, 50, 60, 54, 57, 63, 62, 61, 61, 61, 65, 49, 55, 63, 64, 65,
+  33, 46, 36, 37, 38, 41, 39, 42, 45, 41, 45, 34, 49, 41, 43, 44, 39, 40, 32, 39,
+  40, 39, 39, 33, 44, 34, 55, 40, 40, 39, 55, 40, 33, 44, 50, 39, 47, 42, 45, 50,
+  41, 46, 59, 51, 50, 49, 41, 56, 45, 39, 88, 145, 171, 139, 80, 53, 72, 90, 89, 90,
+  85, 95, 92, 85, 57, 61, 88, 88, 86, 64, 54, 47, 46, 51, 54, 67, 146, 179, 144, 82,
+  58, 80, 98, 94, 106, 90, 96, 97, 79, 63, 65, 80, 86, 86, 68, 49, 42, 47, 56, 56,
+  53, 51, 59, 53, 50, 65, 58, 61, 53, 55, 50, 54, 58, 57, 61, 58, 66, 59, 57, 59,
+  60, 57, 56, 62, 69, 60, 59, 61, 55, 57, 57, 62, 50, 55, 73, 63, 49, 56, 58, 62,
+  44, 41, 44, 40, 46, 43, 38, 41, 50, 35, 35, 36, 50, 48, 47, 45, 44, 37, 38, 47,
+  43, 47, 38, 44, 37, 48, 41, 38, 44, 28, 43, 45, 40, 43, 45, 45, 40, 51, 44, 46,
+  46, 41, 54, 48, 45, 47, 46, 46, 65, 38, 89, 171, 216, 172, 87, 57, 48, 40, 47, 59,
+  49, 43, 56, 51, 44, 82, 143, 173, 144, 75, 43, 51, 49, 53, 50, 96, 173, 213, 164, 102,
+  59, 59, 50, 53, 55, 57, 50, 50, 50, 50, 88, 150, 175, 144, 83, 65, 57, 41, 54, 61,
+  50, 51, 52, 56, 54, 49, 46, 56, 55, 64, 52, 54, 57, 62, 61, 60, 60, 54, 60, 62,
+  58, 51, 56, 66, 54, 56, 54, 63, 59, 61, 66, 52, 56, 63, 59, 61, 71, 52, 61, 63,
+  36, 38, 41, 43, 36, 42, 43, 41, 51, 48, 41, 41, 40, 42, 47, 46, 37, 45, 56, 48,
+  48, 36, 40, 41, 49, 45, 44, 46, 44, 52, 37, 44, 47, 39, 38, 41, 43, 46, 43, 44,
+  51, 57, 37, 40, 47, 42, 51, 39, 51, 41, 92, 179, 221, 177, 94, 45, 49, 49, 46, 55,
+  60, 49, 50, 50, 53, 96, 186, 217, 166, 89, 47, 50, 58, 49, 47, 93, 165, 218, 164, 95,
+  51, 53, 56, 47, 47, 47, 58, 53, 57, 55, 95, 170, 205, 180, 96, 53, 47, 53, 64, 69,
+  54, 62, 46, 55, 54, 58, 59, 53, 57, 62, 56, 65, 50, 60, 50, 53, 50, 63, 60, 55,
+  54, 52, 56, 58, 62, 57, 55, 68, 61, 61, 60, 63, 65, 57, 64, 61, 55, 58, 70, 65,
+  43, 48, 48, 34, 44, 51, 43, 49, 38, 44, 45, 48, 48, 44, 45, 37, 38, 45, 42, 51,
+  47, 45, 51, 43, 38, 40, 50, 40, 48, 38, 44, 44, 49, 40, 42, 48, 50, 43, 46, 40,
+  47, 44, 52, 46, 54, 49, 49, 50, 46, 44, 85, 168, 215, 172, 84, 53, 56, 47, 48, 47,
+  51, 46, 54, 50, 39, 101, 173, 222, 174, 93, 54, 47, 43, 51, 55, 95, 174, 217, 179, 91,
+  49, 59, 45, 55, 53, 57, 61, 48, 55, 63, 90, 175, 206, 171, 95, 56, 55, 50, 50, 58,
+  55, 52, 55, 55, 58, 49, 49, 59, 57, 63, 53, 58, 63, 68, 53, 64, 57, 57, 54, 60,
+  59, 49, 63, 64, 67, 58, 61, 55, 61, 62, 60, 61, 64, 58, 54, 63, 62, 56, 61, 57,
+  37, 44, 43, 46, 47, 39, 37, 49, 39, 43, 45, 40, 36, 40, 46, 43, 41, 49, 52, 49,
+  49, 42, 43, 35, 53, 48, 47, 38, 36, 35, 46, 44, 53, 52, 40, 43, 50, 45, 45, 45,
+  41, 44, 49, 39, 41, 56, 50, 51, 49, 52, 88, 174, 216, 181, 95, 53, 48, 55, 41, 45,
+  52, 43, 45, 38, 49, 92, 181, 215, 175, 103, 53, 56, 50, 51, 51, 99, 173, 216, 180, 93,
+  49, 48, 57, 48, 56, 56, 51, 52, 52, 55, 93, 172, 219, 174, 97, 56, 57, 51, 51, 61,
+  55, 48, 50, 51, 49, 55, 62, 57, 62, 55, 49, 62, 60, 55, 56, 56, 58, 58, 61, 62,
+  61, 56, 55, 57, 60, 58, 59, 47, 66, 55, 55, 65, 66, 54, 68, 58, 62, 63, 59, 71,
+  33, 47, 46, 55, 50, 42, 44, 47, 43, 42, 50, 45, 46, 44, 39, 44, 45, 46, 35, 36,
+  41, 43, 37, 41, 53, 45, 42, 53, 37, 53, 46, 48, 52, 42, 40, 42, 49, 54, 52, 49,
+  42, 39, 46, 44, 48, 46, 47, 41, 47, 42, 94, 168, 219, 171, 90, 43, 51, 56, 45, 50,
+  52, 55, 53, 52, 52, 94, 175, 218, 171, 86, 46, 47, 55, 55, 49, 96, 171, 210, 171, 92,
+  57, 54, 48, 48, 50, 45, 46, 49, 55, 50, 90, 181, 212, 180, 99, 56, 53, 45, 62, 61,
+  57, 68, 55, 62, 66, 60, 60, 55, 57, 53, 50, 57, 49, 56, 65, 60, 54, 52, 63, 58,
+  49, 51, 66, 47, 52, 60, 56, 57, 60, 53, 61, 52, 53, 60, 57, 52, 58, 51, 58, 59,
+  50, 42, 47, 43, 46, 48, 47, 45, 42, 45, 40, 49, 38, 45, 38, 50, 51, 40, 45, 48,
+  41, 43, 46, 46, 51, 54, 52, 39, 53, 46, 41, 45, 41, 47, 41, 44, 47, 45, 52, 50,
+  54, 40, 51, 36, 55, 48, 45, 50, 51, 50, 91, 174, 211, 177, 85, 49, 47, 60, 53, 54,
+  52, 55, 52, 49, 48, 97, 178, 221, 172, 95, 42, 55, 60, 50, 59, 93, 179, 218, 165, 97,
+  46, 49, 55, 45, 52, 56, 58, 56, 51, 61, 99, 175, 211, 166, 97, 60, 57, 56, 59, 54,
+  57, 65, 51, 54, 52, 54, 47, 52, 58, 52, 60, 60, 56, 54, 66, 54, 49, 61, 53, 52,
+  67, 57, 57, 56, 55, 67, 58, 54, 61, 55, 61, 60, 60, 61, 53, 61, 52, 55, 55, 63,
+  41, 36, 36, 41, 45, 35, 43, 48, 47, 43, 47, 46, 42, 42, 49, 43, 32, 44, 40, 44,
+  43, 40, 37, 44, 49, 40, 47, 46, 44, 41, 46, 46, 47, 48, 48, 54, 45, 50, 53, 58,
+  46, 49, 52, 41, 53, 52, 53, 56, 48, 45, 76, 145, 163, 136, 80, 49, 44, 47, 57, 48,
+  44, 51, 50, 50, 55, 96, 182, 218, 184, 101, 45, 43, 43, 53, 58, 88, 141, 175, 148, 96,
+  57, 55, 49, 54, 48, 51, 51, 63, 58, 56, 88, 175, 214, 172, 95, 49, 61, 56, 53, 62,
+  59, 54, 60, 57, 55, 58, 56, 65, 63, 52, 58, 64, 55, 62, 59, 60, 63, 63, 64, 53,
+  65, 55, 56, 57, 63, 61, 55, 60, 61, 69, 64, 58, 67, 61, 62, 62, 66, 61, 64, 63,
+  49, 49, 46, 40, 39, 44, 40, 42, 43, 48, 39, 42, 45, 38, 45, 36, 42, 46, 42, 48,
+  47, 44, 40, 43, 43, 44, 50, 30, 46, 52, 34, 38, 53, 47, 47, 46, 43, 45, 48, 48,
+  54, 48, 50, 55, 50, 47, 53, 50, 46, 52, 59, 75, 94, 82, 67, 44, 53, 56, 50, 52,
+  58, 50, 51, 45, 52, 87, 150, 172, 145, 87, 48, 48, 54, 60, 56, 63, 94, 83, 88, 62,
+  46, 45, 51, 58, 54, 56, 59, 55, 64, 59, 77, 145, 171, 140, 87, 54, 65, 65, 48, 45,
+  59, 63, 56, 58, 50, 58, 60, 52, 65, 57, 53, 51, 53, 63, 56, 64, 60, 52, 54, 56,
+  46, 64, 60, 55, 69, 52, 66, 54, 53, 62, 61, 61, 64, 54, 70, 60, 46, 55, 62, 62,
+  36, 38, 36, 43, 42, 44, 40, 46, 47, 44, 49, 46, 47, 39, 46, 50, 49, 43, 51, 46,
+  52, 48, 50, 50, 44, 47, 44, 45, 47, 43, 48, 46, 45, 45, 54, 40, 43, 43, 55, 53,
+  49, 48, 40, 36, 46, 43, 54, 57, 53, 46, 44, 50, 49, 64, 87, 95, 84, 88, 84, 95,
+  95, 80, 67, 57, 49, 61, 83, 95, 89, 61, 48, 54, 53, 64, 44, 41, 51, 55, 66, 86,
+  99, 97, 94, 96, 102, 87, 89, 63, 49, 61, 70, 86, 91, 89, 74, 57, 53, 60, 52, 61,
+  60, 54, 60, 56, 51, 57, 59, 59, 58, 57, 59, 64, 53, 47, 61, 55, 58, 65, 53, 55,
+  65, 61, 60, 61, 70, 57, 62, 66, 58, 59, 73, 65, 62, 67, 69, 71, 63, 64, 61, 67,
+  42, 35, 49, 50, 36, 43, 39, 39, 45, 44, 40, 48, 58, 36, 46, 43, 40, 48, 49, 43,
+  43, 46, 53, 56, 49, 33, 49, 48, 51, 43, 39, 38, 37, 48, 32, 50, 40, 46, 48, 50,
+  47, 49, 49, 45, 57, 43, 36, 54, 54, 63, 52, 48, 46, 88, 151, 177, 172, 159, 173, 170,
+  173, 137, 79, 49, 52, 55, 52, 58, 46, 50, 49, 58, 56, 53, 49, 52, 48, 54, 79, 148,
+  173, 175, 167, 172, 179, 166, 149, 81, 55, 56, 53, 49, 49, 52, 46, 45, 57, 52, 50, 65,
+  59, 65, 57, 59, 50, 56, 55, 66, 59, 61, 55, 52, 51, 59, 60, 56, 58, 61, 64, 66,
+  56, 60, 65, 63, 65, 61, 64, 59, 59, 63, 56, 61, 65, 57, 66, 66, 64, 62, 52, 65,
+  46, 38, 51, 50, 42, 47, 39, 38, 50, 46, 46, 46, 46, 42, 35, 45, 51, 46, 54, 50,
+  47, 47, 47, 37, 36, 43, 54, 40, 48, 47, 46, 41, 47, 49, 53, 49, 54, 39, 49, 53,
+  40, 54, 44, 53, 44, 58, 45, 37, 46, 51, 50, 43, 47, 95, 173, 217, 218, 218, 218, 218,
+  209, 181, 97, 52, 60, 56, 50, 46, 52, 54, 40, 53, 52, 54, 48, 57, 61, 57, 86, 174,
+  216, 210, 216, 211, 217, 216, 181, 96, 50, 55, 57, 53, 61, 48, 56, 57, 59, 68, 56, 52,
+  70, 56, 52, 65, 55, 61, 61, 65, 55, 62, 50, 57, 64, 52, 60, 61, 58, 58, 60, 60,
+  60, 57, 63, 54, 62, 60, 66, 59, 65, 59, 62, 50, 61, 60, 54, 55, 60, 67, 66, 56,
+  37, 48, 47, 53, 42, 42, 47, 38, 46, 40, 50, 45, 32, 41, 51, 32, 44, 45, 54, 41,
+  44, 49, 46, 57, 48, 46, 45, 54, 43, 46, 39, 44, 46, 47, 47, 49, 44, 51, 53, 57,
+  55, 45, 39, 46, 52, 45, 51, 50, 46, 51, 43, 48, 49, 81, 142, 174, 175, 174, 176, 178,
+  170, 148, 81, 49, 54, 55, 51, 51, 48, 55, 47, 49, 51, 57, 61, 46, 49, 55, 93, 134,
+  174, 175, 169, 170, 174, 174, 141, 86, 62, 57, 50, 60, 61, 60, 58, 55, 60, 51, 47, 64,
+  51, 57, 60, 54, 54, 58, 56, 63, 53, 63, 52, 60, 52, 62, 58, 53, 60, 60, 56, 70,
+  56, 67, 60, 58, 64, 62, 59, 59, 59, 58, 72, 64, 59, 61, 58, 48, 60, 60, 60, 58,
+  38, 49, 43, 46, 50, 42, 47, 49, 42, 40, 35, 37, 47, 38, 45, 36, 48, 47, 55, 39,
+  49, 48, 38, 42, 49, 52, 56, 40, 39, 50, 39, 50, 60, 50, 41, 61, 48, 46, 46, 49,
+  39, 48, 50, 50, 53, 39, 48, 48, 44, 58, 77, 94, 88, 64, 86, 87, 91, 100, 89, 99,
+  86, 88, 70, 83, 84, 82, 66, 53, 50, 50, 61, 47, 60, 55, 61, 77, 87, 85, 82, 84,
+  106, 96, 85, 91, 98, 98, 83, 80, 78, 90, 83, 65, 59, 53, 50, 62, 52, 50, 59, 66,
+  59, 52, 53, 56, 56, 55, 64, 66, 58, 61, 55, 58, 63, 64, 56, 53, 57, 56, 61, 62,
+  63, 56, 63, 68, 60, 55, 62, 57, 69, 63, 56, 56, 62, 67, 64, 67, 62, 69, 61, 58,
+  47, 37, 34, 43, 40, 41, 43, 43, 49, 48, 41, 49, 48, 47, 45, 41, 50, 45, 36, 42,
+  39, 44, 49, 50, 38, 45, 50, 44, 55, 46, 48, 46, 40, 48, 41, 45, 50, 55, 54, 51,
+  45, 49, 50, 52, 48, 57, 47, 53, 55, 88, 139, 177, 142, 79, 54, 47, 44, 50, 53, 59,
+  60, 56, 87, 143, 177, 152, 85, 53, 52, 55, 52, 57, 47, 47, 88, 137, 170, 142, 79, 57,
+  48, 52, 61, 50, 57, 57, 66, 83, 141, 169, 147, 82, 57, 57, 53, 58, 48, 59, 49, 53,
+  62, 62, 59, 58, 51, 56, 58, 58, 57, 62, 56, 47, 59, 56, 62, 53, 66, 68, 59, 60,
+  57, 62, 57, 58, 59, 53, 61, 59, 60, 56, 55, 62, 58, 59, 61, 56, 57, 59, 60, 61,
+  42, 42, 40, 49, 38, 49, 52, 45, 51, 39, 31, 40, 51, 47, 45, 54, 45, 47, 41, 46,
+  46, 45, 41, 48, 46, 41, 49, 36, 43, 48, 42, 36, 43, 49, 53, 49, 35, 47, 46, 50,
+  40, 52, 50, 50, 49, 47, 43, 50, 47, 88, 169, 210, 173, 100, 54, 57, 67, 56, 47, 61,
+  51, 41, 94, 179, 214, 172, 97, 52, 53, 51, 54, 49, 59, 60, 101, 175, 206, 179, 103, 49,
+  46, 54, 49, 61, 60, 59, 49, 94, 176, 217, 168, 101, 64, 59, 49, 60, 56, 53, 59, 61,
+  69, 60, 60, 55, 66, 51, 49, 53, 55, 63, 58, 61, 55, 59, 55, 54, 49, 63, 62, 60,
+  63, 58, 62, 56, 50, 64, 65, 55, 60, 61, 69, 68, 65, 63, 67, 65, 69, 73, 68, 62,
+  48, 50, 44, 42, 49, 47, 43, 49, 48, 35, 48, 42, 45, 43, 49, 46, 56, 43, 42, 38,
+  53, 52, 45, 39, 46, 44, 40, 51, 37, 54, 51, 55, 51, 47, 59, 50, 53, 47, 40, 43,
+  50, 43, 54, 58, 46, 49, 49, 56, 55, 95, 179, 213, 177, 94, 48, 52, 48, 54, 52, 41,
+  48, 47, 90, 173, 213, 179, 87, 49, 51, 48, 49, 52, 56, 52, 97, 172, 213, 182, 91, 54,
+  56, 55, 57, 59, 61, 61, 62, 93, 172, 211, 174, 91, 49, 63, 45, 49, 55, 51, 52, 49,
+  55, 52, 56, 56, 61, 63, 64, 58, 64, 57, 48, 53, 61, 44, 55, 67, 59, 63, 59, 71,
+  59, 68, 60, 65, 56, 59, 59, 62, 60, 61, 66, 61, 69, 64, 73, 70, 59, 69, 66, 62,
+  43, 37, 51, 33, 44, 48, 44, 52, 41, 42, 44, 46, 41, 46, 44, 44, 49, 44, 48, 49,
+  44, 40, 47, 46, 47, 48, 59, 46, 42, 46, 44, 43, 54, 44, 45, 49, 49, 57, 38, 54,
+  57, 48, 43, 57, 58, 50, 47, 66, 42, 90, 173, 221, 172, 88, 47, 54, 41, 49, 43, 52,
+  48, 46, 94, 172, 222, 177, 92, 51, 46, 57, 51, 55, 60, 50, 90, 173, 219, 174, 99, 54,
+  60, 61, 55, 54, 58, 43, 50, 90, 172, 214, 172, 101, 53, 59, 57, 56, 58, 58, 59, 56,
+  53, 58, 64, 58, 54, 59, 55, 56, 52, 54, 67, 62, 59, 56, 60, 55, 57, 55, 56, 58,
+  63, 57, 68, 59, 62, 62, 62, 62, 58, 70, 63, 67, 54, 51, 59, 62, 58, 64, 58, 70,
+  43, 42, 42, 41, 50, 53, 41, 45, 43, 49, 39, 46, 47, 40, 46, 45, 42, 51, 61, 45,
+  56, 57, 45, 42, 49, 41, 47, 55, 47, 61, 42, 52, 53, 37, 52, 42, 42, 49, 41, 59,
+  45, 49, 43, 58, 45, 45, 51, 58, 57, 92, 174, 222, 173, 88, 50, 53, 50, 45, 55, 50,
+  60, 58, 95, 172, 211, 179, 101, 39, 60, 55, 52, 55, 50, 55, 97, 175, 218, 185, 93, 57,
+  60, 58, 52, 56, 53, 57, 59, 101, 177, 226, 176, 92, 61, 62, 58, 48, 53, 53, 52, 57,
+  56, 51, 62, 48, 47, 57, 64, 60, 69, 55, 65, 57, 58, 61, 66, 71, 59, 52, 59, 66,
+  73, 66, 69, 64, 55, 63, 64, 66, 52, 52, 61, 66, 58, 62, 78, 65, 64, 63, 60, 62,
+  39, 38, 54, 43, 45, 49, 39, 41, 51, 42, 53, 50, 47, 49, 51, 41, 45, 42, 46, 48,
+  47, 48, 47, 45, 57, 47, 50, 56, 46, 45, 41, 49, 55, 46, 43, 47, 50, 38, 45, 39,
+  48, 52, 49, 47, 51, 50, 46, 58, 49, 92, 180, 215, 173, 87, 50, 56, 56, 53, 48, 59,
+  55, 56, 89, 174, 220, 173, 85, 45, 56, 57, 54, 52, 61, 58, 83, 178, 220, 174, 99, 58,
+  58, 56, 50, 56, 51, 54, 55, 96, 180, 217, 177, 91, 65, 50, 45, 61, 56, 51, 69, 57,
+  63, 62, 53, 50, 59, 56, 63, 56, 57, 57, 72, 62, 57, 60, 55, 58, 56, 54, 66, 57,
+  57, 64, 63, 66, 52, 61, 58, 64, 67, 59, 70, 61, 64, 58, 64, 63, 63, 57, 60, 63,
+  46, 46, 46, 50, 41, 41, 49, 49, 40, 42, 41, 45, 41, 44, 50, 43, 49, 44, 52, 43,
+  38, 53, 40, 47, 50, 42, 44, 49, 47, 40, 48, 43, 45, 45, 45, 44, 40, 45, 40, 51,
+  57, 53, 48, 41, 49, 53, 47, 54, 46, 91, 160, 215, 173, 97, 44, 50, 52, 50, 51, 53,
+  52, 51, 96, 174, 218, 176, 90, 49, 49, 58, 63, 50, 54, 56, 89, 180, 218, 169, 102, 52,
+  60, 56, 49, 52, 57, 52, 59, 97, 178, 223, 180, 98, 48, 60, 59, 61, 49, 56, 60, 58,
+  63, 57, 63, 56, 58, 61, 65, 61, 54, 56, 61, 59, 70, 62, 64, 57, 53, 57, 50, 57,
+  63, 62, 51, 58, 62, 60, 63, 61, 61, 66, 61, 56, 60, 57, 57, 69, 67, 61, 75, 72,
+  41, 38, 41, 39, 37, 46, 49, 40, 49, 48, 50, 44, 54, 45, 47, 52, 47, 53, 49, 49,
+  38, 45, 54, 47, 41, 45, 46, 52, 45, 46, 51, 51, 53, 52, 48, 41, 47, 55, 47, 43,
+  51, 38, 52, 46, 47, 50, 52, 55, 55, 83, 144, 185, 139, 77, 53, 48, 53, 55, 51, 46,
+  52, 46, 78, 150, 169, 144, 95, 41, 54, 54, 57, 38, 53, 53, 73, 146, 179, 149, 98, 63,
+  58, 57, 51, 44, 69, 51, 53, 83, 146, 172, 133, 92, 61, 58, 59, 66, 56, 48, 63, 56,
+  56, 60, 48, 51, 67, 58, 57, 53, 56, 59, 52, 66, 64, 50, 50, 53, 65, 58, 66, 61,
+  64, 62, 67, 60, 68, 62, 59, 67, 63, 65, 73, 66, 58, 66, 66, 71, 67, 67, 64, 69,
+  49, 55, 39, 43, 44, 43, 49, 51, 39, 39, 53, 56, 37, 49, 49, 51, 41, 44, 48, 40,
+  51, 54, 46, 46, 42, 41, 48, 41, 37, 52, 44, 47, 47, 43, 49, 48, 46, 52, 48, 41,
+  49, 47, 48, 45, 54, 49, 47, 51, 49, 55, 85, 106, 113, 109, 83, 88, 98, 96, 92, 78,
+  64, 58, 60, 80, 93, 71, 60, 53, 50, 50, 60, 55, 51, 54, 68, 87, 108, 117, 107, 98,
+  108, 98, 95, 89, 90, 67, 58, 61, 86, 95, 86, 77, 57, 57, 58, 53, 56, 55, 50, 52,
+  59, 50, 47, 65, 57, 56, 61, 64, 64, 68, 59, 50, 51, 62, 64, 51, 61, 61, 51, 62,
+  59, 70, 62, 63, 61, 60, 72, 67, 59, 66, 69, 74, 67, 64, 69, 60, 65, 60, 65, 64,
+  41, 45, 40, 46, 43, 46, 44, 52, 56, 37, 45, 55, 46, 51, 49, 46, 36, 48, 52, 49,
+  49, 48, 38, 52, 45, 52, 45, 51, 49, 58, 47, 44, 53, 55, 55, 52, 46, 47, 51, 51,
+  52, 47, 51, 55, 55, 48, 49, 56, 50, 46, 46, 85, 143, 173, 169, 172, 171, 175, 183, 147,
+  83, 55, 53, 47, 63, 55, 50, 53, 57, 54, 51, 56, 47, 57, 46, 56, 82, 142, 167, 172,
+  179, 183, 181, 178, 143, 93, 49, 56, 67, 48, 53, 57, 53, 54, 66, 60, 56, 66, 63, 60,
+  64, 56, 66, 64, 55, 59, 66, 62, 55, 56, 53, 59, 49, 53, 58, 65, 57, 63, 54, 58,
+  61, 58, 57, 68, 67, 61, 61, 61, 67, 63, 56, 59, 63, 70, 54, 60, 65, 68, 58, 67,
+  43, 53, 40, 40, 47, 31, 43, 51, 54, 38, 43, 49, 47, 36, 45, 45, 38, 45, 50, 41,
+  49, 40, 47, 51, 50, 51, 49, 43, 46, 52, 41, 50, 43, 53, 46, 52, 47, 48, 57, 53,
+  51, 53, 56, 52, 53, 42, 51, 48, 55, 44, 45, 100, 179, 221, 207, 211, 223, 214, 218, 175,
+  96, 49, 57, 53, 56, 51, 56, 59, 46, 53, 54, 55, 50, 58, 55, 51, 99, 182, 219, 217,
+  212, 211, 218, 217, 169, 94, 54, 61, 65, 57, 57, 54, 53, 47, 54, 58, 59, 48, 52, 63,
+  63, 64, 47, 51, 58, 58, 63, 54, 67, 53, 54, 67, 53, 58, 58, 64, 52, 68, 58, 65,
+  65, 67, 59, 60, 54, 63, 67, 58, 61, 62, 66, 70, 61, 62, 66, 72, 62, 60, 59, 61,
+  47, 41, 52, 48, 51, 46, 46, 49, 45, 41, 44, 41, 46, 50, 41, 49, 47, 48, 34, 46,
+  51, 42, 39, 43, 54, 45, 50, 40, 49, 55, 50, 44, 58, 44, 50, 54, 51, 45, 55, 46,
+  50, 53, 49, 39, 51, 45, 45, 56, 57, 53, 51, 84, 148, 175, 180, 169, 174, 177, 171, 138,
+  82, 54, 58, 51, 56, 56, 49, 60, 54, 61, 54, 45, 48, 58, 49, 54, 87, 154, 184, 178,
+  177, 187, 173, 182, 152, 83, 60, 50, 55, 58, 51, 63, 55, 58, 61, 59, 52, 49, 60, 53,
+  53, 58, 54, 59, 59, 60, 66, 56, 59, 54, 65, 55, 62, 55, 61, 58, 68, 65, 60, 62,
+  56, 69, 56, 59, 49, 55, 59, 58, 54, 66, 54, 66, 62, 65, 59, 61, 60, 58, 70, 68,
+  45, 44, 43, 39, 50, 46, 43, 48, 48, 52, 43, 48, 46, 55, 45, 51, 55, 37, 46, 46,
+  42, 48, 42, 47, 47, 45, 40, 52, 44, 43, 51, 39, 49, 52, 53, 51, 58, 54, 53, 37,
+  51, 43, 51, 41, 51, 53, 58, 55, 52, 52, 54, 66, 78, 99, 100, 86, 90, 86, 96, 82,
+  61, 46, 54, 43, 64, 52, 59, 59, 53, 49, 54, 53, 61, 49, 56, 52, 61, 85, 98, 92,
+  100, 92, 92, 95, 80, 71, 52, 67, 54, 63, 61, 61, 54, 54, 52, 59, 56, 56, 58, 52,
+  53, 51, 59, 60, 66, 60, 72, 60, 58, 57, 58, 59, 71, 58, 66, 58, 70, 59, 58, 64,
+  61, 61, 65, 58, 56, 52, 63, 65, 70, 69, 74, 64, 66, 57, 60, 65, 66, 57, 59, 68,
+  42, 45, 52, 37, 47, 47, 42, 56, 48, 46, 46, 41, 50, 44, 55, 37, 53, 48, 44, 37,
+  45, 42, 44, 50, 49, 50, 42, 58, 53, 53, 47, 48, 44, 56, 41, 45, 45, 55, 45, 50,
+  44, 54, 50, 52, 53, 50, 49, 49, 56, 53, 53, 50, 49, 57, 49, 50, 61, 54, 50, 55,
+  46, 54, 53, 50, 55, 56, 57, 47, 57, 56, 57, 52, 58, 52, 56, 51, 53, 55, 46, 55,
+  53, 61, 65, 67, 49, 55, 52, 55, 60, 56, 60, 59, 60, 55, 57, 54, 60, 65, 58, 57,
+  56, 72, 56, 55, 60, 51, 63, 58, 59, 62, 64, 59, 58, 54, 59, 62, 62, 60, 59, 54,
+  60, 71, 54, 58, 61, 65, 67, 63, 58, 59, 62, 61, 67, 74, 76, 51, 72, 76, 68, 65,
+  42, 44, 56, 44, 45, 47, 53, 56, 45, 46, 37, 47, 46, 47, 44, 36, 53, 48, 52, 40,
+  50, 49, 47, 45, 50, 47, 49, 44, 46, 46, 43, 54, 47, 38, 54, 51, 49, 37, 45, 47,
+  57, 55, 54, 43, 51, 53, 43, 58, 64, 62, 47, 60, 49, 46, 52, 50, 59, 60, 51, 50,
+  51, 44, 60, 59, 55, 49, 46, 58, 52, 50, 57, 54, 58, 59, 58, 59, 58, 49, 63, 59,
+  60, 53, 57, 56, 54, 70, 58, 69, 58, 58, 57, 57, 52, 64, 53, 54, 65, 63, 50, 58,
+  56, 62, 54, 63, 65, 64, 60, 63, 54, 51, 61, 57, 59, 56, 56, 55, 57, 65, 67, 66,
+  58, 62, 61, 65, 56, 63, 72, 63, 69, 68, 62, 58, 61, 62, 67, 66, 64, 58, 67, 75,
+  44, 46, 50, 51, 37, 58, 53, 41, 46, 49, 42, 42, 44, 43, 44, 41, 52, 45, 41, 46,
+  45, 40, 46, 38, 44, 47, 50, 53, 52, 46, 49, 53, 49, 49, 45, 44, 55, 51, 58, 44,
+  53, 56, 50, 44, 50, 48, 42, 49, 46, 54, 51, 53, 52, 59, 54, 45, 48, 45, 55, 55,
+  58, 65, 63, 62, 54, 53, 56, 47, 51, 52, 60, 55, 56, 54, 62, 59, 59, 51, 51, 53,
+  61, 61, 56, 63, 68, 50, 50, 55, 44, 67, 67, 59, 56, 62, 68, 63, 55, 55, 57, 59,
+  55, 63, 63, 57, 66, 66, 64, 53, 66, 62, 57, 58, 59, 64, 62, 59, 55, 61, 63, 66,
+  62, 63, 65, 66, 62, 59, 64, 66, 58, 60, 72, 64, 61, 66, 61, 64, 64, 57, 66, 55,
+};
+
+#endif
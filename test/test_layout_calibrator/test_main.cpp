@@ -0,0 +1,105 @@
+#include <unity.h>
+#include <string.h>
+#include "LayoutCalibrator.h"
+#include "frame_88.h"
+
+// Разметка по кадру "88": calibrateLayout() должен предложить segPos и
+// topLEDs, совпадающие с разметкой по умолчанию из main.cpp (координаты ROI)
+
+static const Rect SEG_POS[2][CAL_SEGMENTS] = {
+  { {57, 37, 6, 3}, {66, 42, 3, 6}, {63, 55, 3, 6}, {53, 63, 6, 3},
+    {50, 55, 3, 6}, {51, 41, 3, 6}, {55, 50, 6, 3} },
+  { {82, 37, 6, 3}, {91, 42, 3, 6}, {88, 55, 3, 6}, {78, 63, 6, 3},
+    {75, 55, 3, 6}, {76, 41, 3, 6}, {80, 50, 6, 3} }
+};
+static const Rect TOP_LEDS[5] = {
+  {17, 12, 3, 3}, {42, 12, 3, 3}, {68, 12, 3, 3}, {94, 12, 3, 3}, {120, 12, 3, 3}
+};
+
+static const int W = FRAME_88_W, H = FRAME_88_H;
+static const Rect ROI = { 0, 0, W, H };
+static uint8_t frame[W * H];   // как в буфере камеры: строки снизу вверх
+
+static void loadFrame() {
+  for (int y = 0; y < H; y++) memcpy(frame + (H - 1 - y) * W, FRAME_88 + y * W, W);
+}
+
+// Центры сравниваются в полупикселях, чтобы не терять нечётные размеры
+static void assertSameCenter(const Rect &expected, const Rect &actual, int tolerance) {
+  TEST_ASSERT_INT_WITHIN(2 * tolerance, 2 * expected.x + expected.w, 2 * actual.x + actual.w);
+  TEST_ASSERT_INT_WITHIN(2 * tolerance, 2 * expected.y + expected.h, 2 * actual.y + actual.h);
+}
+
+static int meanOf(const Rect &r) {
+  int sum = 0;
+  for (int y = r.y; y < r.y + r.h; y++)
+    for (int x = r.x; x < r.x + r.w; x++) sum += FRAME_88[y * W + x];
+  return sum / (r.w * r.h);
+}
+
+void setUp() { loadFrame(); }
+void tearDown() {}
+
+void test_proposes_default_layout_from_88_frame() {
+  LayoutProposal out;
+  TEST_ASSERT_EQUAL_INT(CAL_OK, calibrateLayout(frame, W, H, LUMA_GRAY8, ROI, 2, 5, out));
+  TEST_ASSERT_EQUAL_INT(2, out.digitCount);
+  TEST_ASSERT_EQUAL_INT(5, out.ledCount);
+
+  // Центры сегментов - в пределах 2 пикселей: у наклонного шрифта нижняя
+  // перекладина строится между столбцами и сдвигается вправо
+  for (int d = 0; d < 2; d++) {
+    for (int s = 0; s < CAL_SEGMENTS; s++) {
+      const Rect &r = out.segments[d][s];
+      assertSameCenter(SEG_POS[d][s], r, 2);
+      // Прямоугольник целиком на сегменте: выборка по нему читает "горит"
+      TEST_ASSERT_TRUE(r.w > 0 && r.h > 0);
+      TEST_ASSERT_GREATER_THAN(out.threshold, meanOf(r));
+    }
+  }
+  for (int i = 0; i < 5; i++) {
+    assertSameCenter(TOP_LEDS[i], out.leds[i], 1);
+    TEST_ASSERT_GREATER_THAN(out.threshold, meanOf(out.leds[i]));
+  }
+}
+
+// Кадр, на котором цифр меньше, чем просили, разметку не даёт
+void test_wrong_digit_count_is_rejected() {
+  LayoutProposal out;
+  TEST_ASSERT_EQUAL_INT(CAL_DIGITS_NOT_FOUND, calibrateLayout(frame, W, H, LUMA_GRAY8, ROI, 3, 5, out));
+  TEST_ASSERT_EQUAL_INT(0, out.digitCount);
+}
+
+void test_missing_leds_are_reported() {
+  LayoutProposal out;
+  TEST_ASSERT_EQUAL_INT(CAL_LEDS_NOT_FOUND, calibrateLayout(frame, W, H, LUMA_GRAY8, ROI, 2, 7, out));
+}
+
+void test_flat_frame_has_no_contrast() {
+  memset(frame, 60, sizeof(frame));
+  LayoutProposal out;
+  TEST_ASSERT_EQUAL_INT(CAL_LOW_CONTRAST, calibrateLayout(frame, W, H, LUMA_GRAY8, ROI, 2, 5, out));
+}
+
+void test_roi_outside_frame_is_rejected() {
+  LayoutProposal out;
+  TEST_ASSERT_EQUAL_INT(CAL_BAD_ROI, calibrateLayout(frame, W, H, LUMA_GRAY8, Rect{10, 0, W, H}, 2, 5, out));
+}
+
+void test_bad_profile_is_not_a_bad_roi() {
+  LayoutProposal out;
+  TEST_ASSERT_EQUAL_INT(CAL_BAD_PROFILE, calibrateLayout(frame, W, H, LUMA_GRAY8, ROI, 0, 5, out));
+  TEST_ASSERT_EQUAL_INT(CAL_BAD_PROFILE, calibrateLayout(frame, W, H, LUMA_GRAY8, ROI, CAL_MAX_DIGITS + 1, 5, out));
+  TEST_ASSERT_EQUAL_INT(CAL_BAD_PROFILE, calibrateLayout(frame, W, H, LUMA_GRAY8, ROI, 2, CAL_MAX_LEDS + 1, out));
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_proposes_default_layout_from_88_frame);
+  RUN_TEST(test_wrong_digit_count_is_rejected);
+  RUN_TEST(test_missing_leds_are_reported);
+  RUN_TEST(test_flat_frame_has_no_contrast);
+  RUN_TEST(test_roi_outside_frame_is_rejected);
+  RUN_TEST(test_bad_profile_is_not_a_bad_roi);
+  return UNITY_END();
+}
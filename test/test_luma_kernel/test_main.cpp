@@ -0,0 +1,88 @@
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include "LumaSampler.h"
+
+// Табличное ядро яркости против эталонной формулы: совпадение бит в бит и
+// время на пиксель. Время - на ПК, важно соотношение, а не цифры ESP32.
+
+static uint32_t rng = 1;
+
+static uint32_t nextRandom() {
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return rng;
+}
+
+template <class F>
+static double nanosPerRun(int runs, F f) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < runs; i++) f();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / runs;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_tables_match_reference_on_all_pixels() {
+  TEST_ASSERT_EQUAL_INT(0, lumaSelfTest());
+}
+
+// Отрезки любой длины с любого выравнивания: по два пикселя на чтение и
+// хвосты дают ту же сумму, что эталон по одному
+void test_span_sum_matches_reference() {
+  alignas(4) uint16_t pixels[64 + 2];
+  for (int i = 0; i < 66; i++) pixels[i] = (uint16_t)nextRandom();
+  for (int start = 0; start < 2; start++) {
+    for (int len = 0; len <= 64; len++) {
+      uint32_t ref = 0;
+      for (int i = 0; i < len; i++) ref += rgb565ToGrayRef(pixels[start + i]);
+      TEST_ASSERT_EQUAL_UINT32(ref, lumaSumRGB565((const uint8_t*)(pixels + start), len));
+    }
+  }
+}
+
+void test_gray_and_yuv_sums_match_per_pixel() {
+  alignas(4) uint8_t bytes[2 * 64 + 8];
+  for (size_t i = 0; i < sizeof(bytes); i++) bytes[i] = (uint8_t)nextRandom();
+  for (int start = 0; start < 4; start++) {
+    for (int len = 0; len <= 64; len++) {
+      uint32_t gray = 0, yuv = 0;
+      for (int i = 0; i < len; i++) gray += lumaAt(bytes + start, i, LUMA_GRAY8);
+      TEST_ASSERT_EQUAL_UINT32(gray, lumaSumGray8(bytes + start, len));
+      if (start % 2) continue;   // YUYV идёт по 2 байта на пиксель
+      for (int i = 0; i < len; i++) yuv += lumaAt(bytes + start, i, LUMA_YUV422);
+      TEST_ASSERT_EQUAL_UINT32(yuv, lumaSumYUV422(bytes + start, len));
+    }
+  }
+}
+
+void test_bench_reference_vs_tables() {
+  const int PIXELS = 1024, RUNS = 20000;
+  alignas(4) static uint16_t pixels[PIXELS];
+  for (int i = 0; i < PIXELS; i++) pixels[i] = (uint16_t)nextRandom();
+
+  volatile uint32_t sink = 0;
+  double ref = nanosPerRun(RUNS, [&] {
+    uint32_t acc = 0;
+    for (int i = 0; i < PIXELS; i++) acc += rgb565ToGrayRef(pixels[i]);
+    sink += acc;
+  }) / PIXELS;
+  double lut = nanosPerRun(RUNS, [&] { sink += lumaSumRGB565((const uint8_t*)pixels, PIXELS); }) / PIXELS;
+
+  char msg[128];
+  snprintf(msg, sizeof(msg), "reference %.3f ns/px, tables %.3f ns/px (x%.1f)", ref, lut, ref / lut);
+  TEST_MESSAGE(msg);
+}
+
+int main(int, char **) {
+  initLumaTables();
+  UNITY_BEGIN();
+  RUN_TEST(test_tables_match_reference_on_all_pixels);
+  RUN_TEST(test_span_sum_matches_reference);
+  RUN_TEST(test_gray_and_yuv_sums_match_per_pixel);
+  RUN_TEST(test_bench_reference_vs_tables);
+  return UNITY_END();
+}
@@ -0,0 +1,158 @@
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include "LumaSampler.h"
+
+// План выборки против прежнего попиксельного цикла readDisplay(): те же
+// средние на тех же кадрах и время на кадр. Время - на ПК, так что
+// смотреть стоит на соотношение, а не на абсолютные цифры ESP32.
+
+static const int W = 160, H = 120;
+static const int ROI_X = 10, ROI_Y = 48;
+
+// Разметка по умолчанию (относительно ROI): две цифры и пять светодиодов
+static const Rect LAYOUT[] = {
+  {57, 37, 6, 3}, {66, 42, 3, 6}, {63, 55, 3, 6}, {53, 63, 6, 3},
+  {50, 55, 3, 6}, {51, 41, 3, 6}, {55, 50, 6, 3},
+  {82, 37, 6, 3}, {91, 42, 3, 6}, {88, 55, 3, 6}, {78, 63, 6, 3},
+  {75, 55, 3, 6}, {76, 41, 3, 6}, {80, 50, 6, 3},
+  {17, 12, 3, 3}, {42, 12, 3, 3}, {68, 12, 3, 3}, {94, 12, 3, 3}, {120, 12, 3, 3}
+};
+static const int COUNT = sizeof(LAYOUT) / sizeof(LAYOUT[0]);
+
+static uint16_t frame[W * H];
+static uint32_t rng = 1;
+
+static uint32_t nextRandom() {
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return rng;
+}
+
+static void fillFrame(uint32_t seed) {
+  rng = seed;
+  for (int i = 0; i < W * H; i++) frame[i] = (uint16_t)nextRandom();
+}
+
+// Прежний цикл: обрезка, переворот строки и формула яркости на каждом пикселе
+static int perPixelMean(const uint8_t *buf, int w, int h, int ax, int ay, const Rect &r) {
+  long sumB = 0; int cnt = 0;
+  for (int yy = ay; yy < ay + r.h; yy++) {
+    for (int xx = ax; xx < ax + r.w; xx++) {
+      if (xx < 0 || yy < 0 || xx >= w || yy >= h) continue;
+      int yy2 = (h - 1) - yy;
+      int idx = (yy2 * w + xx) * 2;
+      uint16_t pix = buf[idx] | (buf[idx + 1] << 8);
+
+      int r5 = (pix >> 11) & 0x1F;
+      int g6 = (pix >> 5) & 0x3F;
+      int b5 = pix & 0x1F;
+
+      int gray = ((r5*255/31)*30 + (g6*255/63)*59 + (b5*255/31)*11) / 100;
+      sumB += gray; cnt++;
+    }
+  }
+  return (cnt > 0) ? (int)(sumB / cnt) : 0;
+}
+
+static void perPixelSample(const Rect *rects, int count, int *means) {
+  for (int i = 0; i < count; i++) {
+    means[i] = perPixelMean((const uint8_t*)frame, W, H, ROI_X + rects[i].x, ROI_Y + rects[i].y, rects[i]);
+  }
+}
+
+static void absolute(const Rect *rects, int count, Rect *out) {
+  for (int i = 0; i < count; i++) {
+    out[i] = Rect{ ROI_X + rects[i].x, ROI_Y + rects[i].y, rects[i].w, rects[i].h };
+  }
+}
+
+template <class F>
+static double microsPerRun(int runs, F f) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < runs; i++) f();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(t1 - t0).count() / runs;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_plan_matches_per_pixel_loop() {
+  Rect rects[COUNT];
+  absolute(LAYOUT, COUNT, rects);
+  SamplingPlan plan;
+  TEST_ASSERT_TRUE(plan.compile(rects, COUNT, W, H));
+  TEST_ASSERT_FALSE(plan.usesIntegral());
+
+  for (uint32_t seed = 1; seed <= 20; seed++) {
+    fillFrame(seed * 2654435761u);
+    int expected[COUNT], actual[COUNT];
+    perPixelSample(LAYOUT, COUNT, expected);
+    TEST_ASSERT_TRUE(plan.sample((const uint8_t*)frame, actual));
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, actual, COUNT);
+  }
+}
+
+// Прямоугольники на краю и за краем кадра обрезаются так же, как в цикле
+void test_plan_clips_like_per_pixel_loop() {
+  const Rect edge[] = { {-15, -50, 8, 6}, {145, 68, 10, 6}, {-20, 20, 4, 4}, {150, -60, 3, 3} };
+  const int n = sizeof(edge) / sizeof(edge[0]);
+  Rect rects[n];
+  absolute(edge, n, rects);
+  SamplingPlan plan;
+  TEST_ASSERT_TRUE(plan.compile(rects, n, W, H));
+
+  fillFrame(12345);
+  int expected[n], actual[n];
+  perPixelSample(edge, n, expected);
+  TEST_ASSERT_TRUE(plan.sample((const uint8_t*)frame, actual));
+  TEST_ASSERT_EQUAL_INT_ARRAY(expected, actual, n);
+}
+
+// Крупные перекрывающиеся прямоугольники уходят в интегральное изображение
+void test_integral_fallback_matches_per_pixel_loop() {
+  const Rect big[] = { {0, 0, 100, 60}, {20, 10, 100, 60}, {40, 5, 90, 50} };
+  const int n = sizeof(big) / sizeof(big[0]);
+  Rect rects[n];
+  absolute(big, n, rects);
+  SamplingPlan plan;
+  TEST_ASSERT_TRUE(plan.compile(rects, n, W, H));
+  TEST_ASSERT_TRUE(plan.usesIntegral());
+
+  fillFrame(777);
+  int expected[n], actual[n];
+  perPixelSample(big, n, expected);
+  TEST_ASSERT_TRUE(plan.sample((const uint8_t*)frame, actual));
+  TEST_ASSERT_EQUAL_INT_ARRAY(expected, actual, n);
+}
+
+void test_bench_plan_vs_per_pixel_loop() {
+  const int RUNS = 20000;
+  Rect rects[COUNT];
+  absolute(LAYOUT, COUNT, rects);
+  SamplingPlan plan;
+  TEST_ASSERT_TRUE(plan.compile(rects, COUNT, W, H));
+  fillFrame(42);
+
+  int means[COUNT];
+  volatile int sink = 0;
+  double before = microsPerRun(RUNS, [&] { perPixelSample(LAYOUT, COUNT, means); sink += means[0]; });
+  double after = microsPerRun(RUNS, [&] { plan.sample((const uint8_t*)frame, means); sink += means[0]; });
+
+  char msg[160];
+  snprintf(msg, sizeof(msg), "per-pixel loop %.3f us, sampling plan %.3f us per frame (%d rects, %d px, x%.1f)",
+           before, after, COUNT, plan.pixelCount(), before / after);
+  TEST_MESSAGE(msg);
+}
+
+int main(int, char **) {
+  initLumaTables();
+  UNITY_BEGIN();
+  RUN_TEST(test_plan_matches_per_pixel_loop);
+  RUN_TEST(test_plan_clips_like_per_pixel_loop);
+  RUN_TEST(test_integral_fallback_matches_per_pixel_loop);
+  RUN_TEST(test_bench_plan_vs_per_pixel_loop);
+  return UNITY_END();
+}
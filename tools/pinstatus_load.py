@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""Нагрузочный тест порта 80: много одновременных опросов /pinstatus.
+
+Для каждого числа опрашивающих (по умолчанию 0, 4, 16, 32) тест сбрасывает
+счётчики (/setsampling?reset=1 и чтение /sampling), гоняет опросы заданное
+время и снова читает /sampling. Каждая ступень идёт дважды: только
+/pinstatus и вместе с --frames клиентами, без паузы качающими /frame.
+Печатает задержку loop() (loop_avg_us, loop_max_us), самый длинный
+интервал между чтениями дисплея (max_interval_ms, over_budget) и время
+ответа /pinstatus. Задержка loop() не должна расти ни с числом
+опрашивающих, ни от /frame.
+
+    python3 tools/pinstatus_load.py 192.168.1.50 --pollers 0 4 16 32 --frames 2 --seconds 20
+
+Только стандартная библиотека Python.
+"""
+
+import argparse
+import json
+import threading
+import time
+import urllib.request
+
+
+def get(base, path, timeout):
+    with urllib.request.urlopen(base + path, timeout=timeout) as r:
+        return r.read()
+
+
+def poller(base, path, stop, timeout, out):
+    ok = errors = 0
+    latencies = []
+    while not stop.is_set():
+        t0 = time.monotonic()
+        try:
+            get(base, path, timeout)
+            latencies.append(time.monotonic() - t0)
+            ok += 1
+        except Exception:
+            errors += 1
+            time.sleep(0.05)
+    out.append((ok, errors, latencies))
+
+
+def percentile(values, p):
+    if not values:
+        return 0.0
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * p))]
+
+
+def phase(base, pollers, frames, seconds, timeout):
+    get(base, "/setsampling?reset=1", timeout)
+    get(base, "/sampling", timeout)   # чтение сбрасывает loop_avg_us/loop_max_us
+
+    stop = threading.Event()
+    results, frameResults = [], []
+    threads = [threading.Thread(target=poller, args=(base, "/pinstatus", stop, timeout, results))
+               for _ in range(pollers)]
+    threads += [threading.Thread(target=poller, args=(base, "/frame?fmt=png", stop, timeout, frameResults))
+                for _ in range(frames)]
+    for t in threads:
+        t.start()
+    time.sleep(seconds)
+    stop.set()
+    for t in threads:
+        t.join()
+
+    sampling = json.loads(get(base, "/sampling", timeout))
+    ok = sum(r[0] for r in results)
+    errors = sum(r[1] for r in results)
+    latencies = [x for r in results for x in r[2]]
+    return {
+        "pollers": pollers,
+        "frames": frames,
+        "frame_per_s": sum(r[0] for r in frameResults) / seconds,
+        "req_per_s": ok / seconds,
+        "errors": errors,
+        "p50_ms": percentile(latencies, 0.5) * 1000,
+        "p95_ms": percentile(latencies, 0.95) * 1000,
+        "max_ms": max(latencies, default=0.0) * 1000,
+        "loop_avg_us": sampling.get("loop_avg_us", 0),
+        "loop_max_us": sampling.get("loop_max_us", 0),
+        "max_interval_ms": sampling.get("max_interval_ms", 0),
+        "over_budget": sampling.get("over_budget", 0),
+    }
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("host", help="адрес ESP32-CAM")
+    ap.add_argument("--pollers", type=int, nargs="+", default=[0, 4, 16, 32])
+    ap.add_argument("--frames", type=int, default=2,
+                    help="клиентов /frame во втором проходе каждой ступени (0 - без него)")
+    ap.add_argument("--seconds", type=float, default=20)
+    ap.add_argument("--timeout", type=float, default=5)
+    args = ap.parse_args()
+    base = args.host if args.host.startswith("http") else "http://" + args.host
+
+    columns = ["pollers", "frames", "frame_per_s", "req_per_s", "errors", "p50_ms", "p95_ms", "max_ms",
+               "loop_avg_us", "loop_max_us", "max_interval_ms", "over_budget"]
+    print(" ".join("%12s" % c for c in columns))
+    for n in args.pollers:
+        for frames in sorted({0, args.frames}):
+            row = phase(base, n, frames, args.seconds, args.timeout)
+            print(" ".join("%12.1f" % row[c] if isinstance(row[c], float) else "%12d" % row[c]
+                           for c in columns), flush=True)
+
+
+if __name__ == "__main__":
+    main()